@@ -12,6 +12,8 @@
 
 int main(int argc, const char* argv[])
 {
+	int result = 0;
+
 	for (int index = 0; index < argc; index++) {
 		if ((strcmp("fingerprint", argv[index]) == 0) && ((index + 1) <= argc)) {
 			const char *filePath = argv[++index];
@@ -34,8 +36,78 @@ int main(int argc, const char* argv[])
 
 			// cleanup
 			FingerprintFree(fingerprint);
+		} else if ((strcmp("build-index", argv[index]) == 0) && ((index + 2) < argc)) {
+			// build-index <index file> <raw file> ... (the reference ids are the file numbers)
+			// (fails without writing the index if any reference is not added)
+			const char *indexPath = argv[++index];
+			FingerprintIndex *fingerprintIndex = FingerprintIndexCreate();
+			int numReferences = 0;
+			int numAdded = 0;
+
+			for (; (index + 1) < argc; numReferences++) {
+				const char *filePath = argv[++index];
+
+				printf("Adding reference %d: '%s'\n", numReferences, filePath);
+
+				Fingerprint *fingerprint = ExtractFingerprintFromRawFile(filePath);
+				if (fingerprint == NULL) {
+					printf("Error generating fingerprint.\n");
+					continue;
+				}
+
+				if (FingerprintIndexAdd(fingerprintIndex, numReferences, fingerprint) == 1) {
+					numAdded += 1;
+				} else {
+					printf("Error adding reference: '%s'\n", filePath);
+				}
+				FingerprintFree(fingerprint);
+			}
+
+			printf("Added %d of %d references\n", numAdded, numReferences);
+
+			// write the index file
+			if (numAdded != numReferences) {
+				printf("Error building index: '%s'\n", indexPath);
+				result = 1;
+			} else if (FingerprintIndexWrite(fingerprintIndex, indexPath)) {
+				printf("Index: '%s' (%d references)\n", indexPath, FingerprintIndexGetNumReferences(fingerprintIndex));
+			} else {
+				printf("Error writing index: '%s'\n", indexPath);
+				result = 1;
+			}
+
+			// cleanup
+			FingerprintIndexFree(fingerprintIndex);
+		} else if ((strcmp("query-index", argv[index]) == 0) && ((index + 2) < argc)) {
+			// query-index <index file> <raw file>
+			const char *indexPath = argv[++index];
+			const char *filePath = argv[++index];
+
+			FingerprintIndex *fingerprintIndex = FingerprintIndexOpen(indexPath);
+			if (fingerprintIndex == NULL) {
+				printf("Error opening index: '%s'\n", indexPath);
+				continue;
+			}
+
+			Fingerprint *fingerprint = ExtractFingerprintFromRawFile(filePath);
+			if (fingerprint == NULL) {
+				printf("Error generating fingerprint.\n");
+				FingerprintIndexFree(fingerprintIndex);
+				continue;
+			}
+
+			// print the best matches
+			FingerprintIndexMatch matches[10];
+			int numMatches = FingerprintIndexQuery(fingerprintIndex, fingerprint, matches, 10);
+			for (int c = 0; c < numMatches; c++) {
+				printf("Reference %d: similarity %.3f, start time %.2f\n", matches[c].referenceId, matches[c].similarity.similarity, matches[c].similarity.mostSimilarStartTime);
+			}
+
+			// cleanup
+			FingerprintFree(fingerprint);
+			FingerprintIndexFree(fingerprintIndex);
 		}
 	}
 
-	return 0;
+	return result;
 }
@@ -9,11 +9,8 @@
 #ifndef FASTFOURIERTRANSFORM_H
 #define FASTFOURIERTRANSFORM_H
 
-#if __APPLE__
-#include <Accelerate/Accelerate.h>
-#endif // __APPLE
-
 #include <vector>
+#include "FastFourierTransformBackend.h"
 
 using std::vector;
 
@@ -21,40 +18,34 @@ class FastFourierTransform {
 
 public:
 
+	// the backend used by new transforms (FINGERPRINT_FFT_BACKEND unless changed at runtime)
+	static FastFourierTransformBackendType getDefaultBackendType();
+	static bool setDefaultBackendType(FastFourierTransformBackendType type);
+
 	FastFourierTransform(int numberOfSamples);
-	~FastFourierTransform();
+	FastFourierTransform(int numberOfSamples, FastFourierTransformBackendType type);
+
+	inline FastFourierTransformBackendType getBackendType() const
+	{
+		return backend->getType();
+	}
+
+	inline int getNumMagnitudes() const
+	{
+		return (int)outFFTData.size();
+	}
 
 	vector<float> getMagnitudes(const vector<float> &timeDomainData);
 
+	// transform numFrames frames of numberOfSamples floats (framesStride floats apart) and
+	// write getNumMagnitudes() magnitudes per frame (magnitudesStride floats apart)
+	void getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride);
+
 private:
 
-	int fftFrameSize { 0 };
+	unique_ptr<FastFourierTransformBackend> backend;
 	vector<float> outFFTData;
 
-#if __APPLE__
-	// ios accelerated fft
-	vector<float> complexReal;
-	vector<float> complexImag;
-	FFTSetup fftSetup { nil };
-
-	vector<float> getMagnitudesAcceleratedFFT(const vector<float> &timeDomainData);
-#endif // __APPLE__
-
-	// fft
-	vector<int> bitm_array;
-	vector<float> w;
-	int fftFrameSize2 { 0 };
-
-	vector<float> getMagnitudesJavaFFT(const vector<float> &timeDomainData);
-	void setup();
-	void transform(vector<float> &data);
-	vector<float> computeTwiddleFactors(int fftFrameSize);
-	void calc(int fftFrameSize, vector<float> &data, vector<float> &w);
-	void calcF2E(int fftFrameSize, vector<float> &data, int i, int nstep, vector<float> &w);
-	void calcF4F(int fftFrameSize, vector<float> &data, int i, int nstep, vector<float> &w);
-	void calcF4FE(int fftFrameSize, vector<float> &data, int i, int nstep, vector<float> &w);
-	void bitreversal(vector<float> &data);
-
 };
 
 #endif /* FASTFOURIERTRANSFORM_H */
@@ -0,0 +1,77 @@
+//
+//  FastFourierTransformAVX2.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FastFourierTransformSIMD.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+// Only the kernel below is compiled for avx2 (without fma, so that the results stay
+// bit-identical to the scalar kernel). It is selected at runtime when the cpu supports it.
+// All other headers must be included above this point.
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "FastFourierTransformKernel.h"
+
+namespace {
+
+struct FloatLanesAVX2 {
+
+	static const int numLanes = 8;
+
+	__m256 v;
+
+	static inline FloatLanesAVX2 load(const float *pointer) { return { _mm256_loadu_ps(pointer) }; }
+	static inline FloatLanesAVX2 broadcast(float value) { return { _mm256_set1_ps(value) }; }
+	inline void store(float *pointer) const { _mm256_storeu_ps(pointer, v); }
+
+	inline FloatLanesAVX2 operator+(const FloatLanesAVX2 &other) const { return { _mm256_add_ps(v, other.v) }; }
+	inline FloatLanesAVX2 operator-(const FloatLanesAVX2 &other) const { return { _mm256_sub_ps(v, other.v) }; }
+	inline FloatLanesAVX2 operator*(const FloatLanesAVX2 &other) const { return { _mm256_mul_ps(v, other.v) }; }
+	inline FloatLanesAVX2 sqrt() const { return { _mm256_sqrt_ps(v) }; }
+
+};
+
+typedef FastFourierTransformKernel<FloatLanesAVX2> AVX2Kernel;
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const FastFourierTransformSIMD *getFastFourierTransformAVX2()
+{
+	static const FastFourierTransformSIMD avx2SIMD = {
+		FastFourierTransformInstructionSet::avx2, FloatLanesAVX2::numLanes, &AVX2Kernel::transform, &AVX2Kernel::magnitudes
+	};
+
+	if (!__builtin_cpu_supports("avx2")) {
+		return NULL;
+	}
+
+	return &avx2SIMD;
+}
+
+#else
+
+const FastFourierTransformSIMD *getFastFourierTransformAVX2()
+{
+	return NULL;
+}
+
+#endif // __x86_64__ || __i386__
@@ -0,0 +1,90 @@
+//
+//  FastFourierTransformAccelerate.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FastFourierTransformAccelerate.h"
+
+#if __APPLE__
+
+#include <math.h>
+
+
+FastFourierTransformAccelerate::FastFourierTransformAccelerate(int numberOfSamples)
+{
+	plan = FastFourierTransformPlan::get(numberOfSamples);
+	fftFrameSize = plan->fftFrameSize;
+	numMagnitudes = (fftFrameSize / 2);
+
+	complexReal.resize(fftFrameSize);
+	complexImag.resize(fftFrameSize);
+}
+
+FastFourierTransformBackendType FastFourierTransformAccelerate::getType() const
+{
+	return FastFourierTransformBackendType::accelerate;
+}
+
+int FastFourierTransformAccelerate::getNumMagnitudes() const
+{
+	return numMagnitudes;
+}
+
+void FastFourierTransformAccelerate::transform(const float *timeDomainData, float *spectrum)
+{
+	if (!transformSplitComplex(timeDomainData)) {
+		return;
+	}
+
+	// copy the split complex result back to an interleaved complex vector
+	DSPSplitComplex complex;
+	complex.realp = complexReal.data();
+	complex.imagp = complexImag.data();
+	vDSP_ztoc(&complex, 1, (DSPComplex*)spectrum, 2, fftFrameSize);
+}
+
+void FastFourierTransformAccelerate::getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride)
+{
+	for (int i = 0; i < numFrames; i++) {
+		if (!transformSplitComplex(frames + ((size_t)i * framesStride))) {
+			return;
+		}
+
+		// TODO: perform this step with vDSP
+
+		float *frameMagnitudes = magnitudes + ((size_t)i * magnitudesStride);
+		for (int c = 0; c < numMagnitudes; c++) {
+			float value = (complexReal[c] * complexReal[c]) + (complexImag[c] * complexImag[c]);
+			frameMagnitudes[c] = sqrtf(value);
+		}
+	}
+}
+
+// MARK: -
+// MARK: Private
+
+bool FastFourierTransformAccelerate::transformSplitComplex(const float *timeDomainData)
+{
+	// safety check
+	if (plan->fftSetup == nil) {
+		return false;
+	}
+
+	// copy the contents of an interleaved complex vector C to a split complex vector Z; single precision.
+	const DSPComplex *interleavedData = (const DSPComplex*)timeDomainData;
+	DSPSplitComplex complex;
+	complex.realp = complexReal.data();
+	complex.imagp = complexImag.data();
+	vDSP_ctoz(interleavedData, 2, &complex, 1, fftFrameSize);
+
+	// in-place single-precision complex discrete Fourier transform
+	vDSP_fft_zip(plan->fftSetup, &complex, 1, plan->log2n, (FFTDirection)FFT_FORWARD);
+
+	return true;
+}
+
+#endif // __APPLE__
@@ -0,0 +1,48 @@
+//
+//  FastFourierTransformAccelerate.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMACCELERATE_H
+#define FASTFOURIERTRANSFORMACCELERATE_H
+
+#if __APPLE__
+
+#include <vector>
+#include "FastFourierTransformBackend.h"
+#include "FastFourierTransformPlan.h"
+
+using std::vector;
+
+// ios accelerated fft (vDSP)
+class FastFourierTransformAccelerate : public FastFourierTransformBackend {
+
+public:
+
+	FastFourierTransformAccelerate(int numberOfSamples);
+
+	FastFourierTransformBackendType getType() const override;
+	int getNumMagnitudes() const override;
+	void transform(const float *timeDomainData, float *spectrum) override;
+	void getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride) override;
+
+private:
+
+	// shared vDSP setup
+	shared_ptr<const FastFourierTransformPlan> plan;
+	int fftFrameSize { 0 };
+	int numMagnitudes { 0 };
+
+	vector<float> complexReal;
+	vector<float> complexImag;
+
+	bool transformSplitComplex(const float *timeDomainData);
+
+};
+
+#endif // __APPLE__
+
+#endif /* FASTFOURIERTRANSFORMACCELERATE_H */
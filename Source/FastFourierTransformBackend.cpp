@@ -0,0 +1,51 @@
+//
+//  FastFourierTransformBackend.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FastFourierTransformAccelerate.h"
+#include "FastFourierTransformBackend.h"
+#include "FastFourierTransformJava.h"
+
+
+bool FastFourierTransformBackend::isAvailable(FastFourierTransformBackendType type)
+{
+	switch (type) {
+
+		case FastFourierTransformBackendType::java:
+			return true;
+
+		case FastFourierTransformBackendType::accelerate:
+#if __APPLE__
+			return true;
+#else
+			return false;
+#endif // __APPLE__
+
+	}
+
+	return false;
+}
+
+unique_ptr<FastFourierTransformBackend> FastFourierTransformBackend::create(FastFourierTransformBackendType type, int numberOfSamples)
+{
+	switch (type) {
+
+		case FastFourierTransformBackendType::java:
+			return unique_ptr<FastFourierTransformBackend>(new FastFourierTransformJava(numberOfSamples));
+
+		case FastFourierTransformBackendType::accelerate:
+#if __APPLE__
+			return unique_ptr<FastFourierTransformBackend>(new FastFourierTransformAccelerate(numberOfSamples));
+#else
+			return nullptr;
+#endif // __APPLE__
+
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,57 @@
+//
+//  FastFourierTransformBackend.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMBACKEND_H
+#define FASTFOURIERTRANSFORMBACKEND_H
+
+#include <memory>
+
+using std::unique_ptr;
+
+enum class FastFourierTransformBackendType {
+	java,		// Karl Helgason's fft (portable, simd across frames)
+	accelerate	// vDSP (Apple platforms only)
+};
+
+// the backend used when none is selected, can be overridden with -DFINGERPRINT_FFT_BACKEND=java
+#ifndef FINGERPRINT_FFT_BACKEND
+#if __APPLE__
+#define FINGERPRINT_FFT_BACKEND accelerate
+#else
+#define FINGERPRINT_FFT_BACKEND java
+#endif // __APPLE__
+#endif // FINGERPRINT_FFT_BACKEND
+
+// An fft engine for one frame size. The frames are numberOfSamples floats that are
+// transformed as (numberOfSamples / 2) interleaved complex values.
+class FastFourierTransformBackend {
+
+public:
+
+	static bool isAvailable(FastFourierTransformBackendType type);
+
+	// create the backend (and its plan), returns NULL if the backend is not available
+	static unique_ptr<FastFourierTransformBackend> create(FastFourierTransformBackendType type, int numberOfSamples);
+
+	virtual ~FastFourierTransformBackend() { }
+
+	virtual FastFourierTransformBackendType getType() const = 0;
+
+	// number of magnitudes per frame (the positive frequency components)
+	virtual int getNumMagnitudes() const = 0;
+
+	// forward transform of one frame, spectrum receives numberOfSamples floats (interleaved complex)
+	virtual void transform(const float *timeDomainData, float *spectrum) = 0;
+
+	// transform numFrames frames (framesStride floats apart) and write getNumMagnitudes()
+	// magnitudes per frame (magnitudesStride floats apart)
+	virtual void getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride) = 0;
+
+};
+
+#endif /* FASTFOURIERTRANSFORMBACKEND_H */
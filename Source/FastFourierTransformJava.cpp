@@ -0,0 +1,102 @@
+//
+//  FastFourierTransformJava.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include "FastFourierTransformJava.h"
+#include "FastFourierTransformKernel.h"
+#include "FloatLanes.h"
+
+
+FastFourierTransformJava::FastFourierTransformJava(int numberOfSamples)
+{
+	// borrow the shared plan, only the scratch buffers are per instance
+	plan = FastFourierTransformPlan::get(numberOfSamples);
+	simd = &FastFourierTransformSIMD::getBest();
+	numMagnitudes = (plan->fftFrameSize / 2);
+}
+
+bool FastFourierTransformJava::setInstructionSet(FastFourierTransformInstructionSet instructionSet)
+{
+	const FastFourierTransformSIMD *selected = FastFourierTransformSIMD::get(instructionSet);
+	if (selected == NULL) {
+		return false;
+	}
+
+	simd = selected;
+	return true;
+}
+
+FastFourierTransformBackendType FastFourierTransformJava::getType() const
+{
+	return FastFourierTransformBackendType::java;
+}
+
+int FastFourierTransformJava::getNumMagnitudes() const
+{
+	return numMagnitudes;
+}
+
+void FastFourierTransformJava::transform(const float *timeDomainData, float *spectrum)
+{
+	typedef FastFourierTransformKernel<FloatLanes<1>> Kernel;
+
+	std::copy(timeDomainData, timeDomainData + plan->fftFrameSize2, spectrum);
+	Kernel::transform(*plan, spectrum);
+}
+
+void FastFourierTransformJava::getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride)
+{
+	typedef FastFourierTransformKernel<FloatLanes<1>> Kernel;
+
+	int numSamples = plan->fftFrameSize2;
+
+	// a single frame does not benefit from the interleaved layout
+	if (numFrames == 1) {
+		amplitudes.assign(frames, frames + numSamples);
+		Kernel::transform(*plan, amplitudes.data());
+		Kernel::magnitudes(*plan, amplitudes.data(), magnitudes);
+		return;
+	}
+
+	int numFramesPerBatch = simd->numLanes;
+	batchAmplitudes.resize(numSamples * numFramesPerBatch);
+	batchMagnitudes.resize(numMagnitudes * numFramesPerBatch);
+
+	for (int firstFrame = 0; firstFrame < numFrames; firstFrame += numFramesPerBatch) {
+		int numBatchFrames = ((numFrames - firstFrame) < numFramesPerBatch) ? (numFrames - firstFrame) : numFramesPerBatch;
+
+		// interleave the frames, unused lanes of the last batch are zero
+		for (int l = 0; l < numFramesPerBatch; l++) {
+			float *lane = batchAmplitudes.data() + l;
+			if (l < numBatchFrames) {
+				const float *frame = frames + ((size_t)(firstFrame + l) * framesStride);
+				for (int n = 0; n < numSamples; n++) {
+					lane[n * numFramesPerBatch] = frame[n];
+				}
+			} else {
+				for (int n = 0; n < numSamples; n++) {
+					lane[n * numFramesPerBatch] = 0.0f;
+				}
+			}
+		}
+
+		// perform the fft on all lanes at once
+		simd->transform(*plan, batchAmplitudes.data());
+		simd->magnitudes(*plan, batchAmplitudes.data(), batchMagnitudes.data());
+
+		// de-interleave the magnitudes
+		for (int l = 0; l < numBatchFrames; l++) {
+			const float *lane = batchMagnitudes.data() + l;
+			float *frameMagnitudes = magnitudes + ((size_t)(firstFrame + l) * magnitudesStride);
+			for (int c = 0; c < numMagnitudes; c++) {
+				frameMagnitudes[c] = lane[c * numFramesPerBatch];
+			}
+		}
+	}
+}
@@ -0,0 +1,53 @@
+//
+//  FastFourierTransformJava.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMJAVA_H
+#define FASTFOURIERTRANSFORMJAVA_H
+
+#include <vector>
+#include "FastFourierTransformBackend.h"
+#include "FastFourierTransformPlan.h"
+#include "FastFourierTransformSIMD.h"
+
+using std::vector;
+
+// The java fft (Karl Helgason), batched frames use the simd kernel selected at runtime.
+class FastFourierTransformJava : public FastFourierTransformBackend {
+
+public:
+
+	FastFourierTransformJava(int numberOfSamples);
+
+	// select the kernel of the batched transform (the fastest supported one is the default)
+	bool setInstructionSet(FastFourierTransformInstructionSet instructionSet);
+
+	// number of frames that are transformed together by the batched getMagnitudes()
+	inline int getNumFramesPerBatch() const
+	{
+		return simd->numLanes;
+	}
+
+	FastFourierTransformBackendType getType() const override;
+	int getNumMagnitudes() const override;
+	void transform(const float *timeDomainData, float *spectrum) override;
+	void getMagnitudes(const float *frames, int framesStride, int numFrames, float *magnitudes, int magnitudesStride) override;
+
+private:
+
+	// shared twiddle factors and bit-reversal table
+	shared_ptr<const FastFourierTransformPlan> plan;
+	const FastFourierTransformSIMD *simd { nullptr };
+	int numMagnitudes { 0 };
+
+	vector<float> amplitudes;
+	vector<float> batchAmplitudes;	// frames interleaved for the batched transform
+	vector<float> batchMagnitudes;
+
+};
+
+#endif /* FASTFOURIERTRANSFORMJAVA_H */
@@ -0,0 +1,403 @@
+//
+//  FastFourierTransformKernel.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMKERNEL_H
+#define FASTFOURIERTRANSFORMKERNEL_H
+
+#include "FastFourierTransformPlan.h"
+
+/*
+ * Fast Fourier Transformer.
+ *
+ * @author Karl Helgason
+ *
+ * Copyright 2007 Sun Microsystems, Inc. All Rights Reserved. DO NOT ALTER
+ * OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER. This code is free
+ * software; you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License version 2 only, as published by the Free
+ * Software Foundation. Sun designates this particular file as subject to
+ * the "Classpath" exception as provided by Sun in the LICENSE file that
+ * accompanied this code. This code is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License version 2 for more details (a copy is included in the
+ * LICENSE file that accompanied this code). You should have received a copy
+ * of the GNU General Public License version 2 along with this work; if not,
+ * write to the Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301 USA. Please contact Sun Microsystems, Inc., 4150
+ * Network Circle, Santa Clara, CA 95054 USA or visit www.sun.com if you
+ * need additional information or have any questions.
+ */
+
+// The java fft butterflies, written against a lane type so that several frames can be
+// transformed at once. Element n of lane l is stored at data[n * Lanes::numLanes + l],
+// i.e. the frames are interleaved. With a single lane this is the plain java fft.
+//
+// Data = Interlaced float array to be transformed.
+// The order is: real (sin), complex (cos)
+// Framesize must be power of 2
+
+template <class Lanes>
+class FastFourierTransformKernel {
+
+public:
+
+	static void transform(const FastFourierTransformPlan &plan, float *data)
+	{
+		bitreversal(plan, data);
+		calc(plan.fftFrameSize, data, plan.w.data(), ((int)plan.w.size() >> 1));
+	}
+
+	// FFT produces a transformed pair of arrays where the first half of the
+	// values represent positive frequency components and the second half
+	// represents negative frequency components.
+	// we omit the negative ones
+	static void magnitudes(const FastFourierTransformPlan &plan, const float *data, float *outFFTData)
+	{
+		for (int i = 0; i < plan.fftFrameSize; i += 2) {
+			Lanes real = get(data, i);
+			Lanes imag = get(data, i + 1);
+			Lanes value = (real * real) + (imag * imag);
+			set(outFFTData, (i >> 1), value.sqrt());
+		}
+	}
+
+private:
+
+	static inline Lanes get(const float *data, int index)
+	{
+		return Lanes::load(data + (index * Lanes::numLanes));
+	}
+
+	static inline void set(float *data, int index, const Lanes &value)
+	{
+		value.store(data + (index * Lanes::numLanes));
+	}
+
+	static inline void swap(float *data, int n, int m)
+	{
+		Lanes temp = get(data, n);
+		set(data, n, get(data, m));
+		set(data, m, temp);
+	}
+
+	static void calc(int fftFrameSize, float *data, const float *w, int w_len)
+	{
+		int fftFrameSize2 = (fftFrameSize << 1);
+		int nstep = 2;
+		if (nstep >= fftFrameSize2) {
+			return;
+		}
+
+		int i = nstep - 2;
+		calcF4F(fftFrameSize, data, i, nstep, w, w_len);
+	}
+
+	static void calcF2E(int fftFrameSize, float *data, int i, int nstep, const float *w)
+	{
+		int jmax = nstep;
+		for (int n = 0; n < jmax; n += 2) {
+			Lanes wr = Lanes::broadcast(w[i++]);
+			Lanes wi = Lanes::broadcast(w[i++]);
+			int m = n + jmax;
+			Lanes datam_r = get(data, m);
+			Lanes datam_i = get(data, m + 1);
+			Lanes datan_r = get(data, n);
+			Lanes datan_i = get(data, n + 1);
+			Lanes tempr = datam_r * wr - datam_i * wi;
+			Lanes tempi = datam_r * wi + datam_i * wr;
+			set(data, m, datan_r - tempr);
+			set(data, m + 1, datan_i - tempi);
+			set(data, n, datan_r + tempr);
+			set(data, n + 1, datan_i + tempi);
+		}
+	}
+
+	// Perform Factor-4 Decomposition with 3 * complex operators and 8 +/-
+	// complex operators
+	static void calcF4F(int fftFrameSize, float *data, int i, int nstep, const float *w, int w_len)
+	{
+		int fftFrameSize2 = fftFrameSize << 1; // 2*fftFrameSize;
+		// Factor-4 Decomposition
+
+		while (nstep < fftFrameSize2) {
+
+			if (nstep << 2 == fftFrameSize2) {
+				// Goto Factor-4 Final Decomposition
+				calcF4FE(fftFrameSize, data, i, nstep, w, w_len);
+				return;
+			}
+			int jmax = nstep;
+			int nnstep = nstep << 1;
+			if (nnstep == fftFrameSize2) {
+				// Factor-4 Decomposition not possible
+				calcF2E(fftFrameSize, data, i, nstep, w);
+				return;
+			}
+			nstep <<= 2;
+			int ii = i + jmax;
+			int iii = i + w_len;
+
+			{
+				i += 2;
+				ii += 2;
+				iii += 2;
+
+				for (int n = 0; n < fftFrameSize2; n += nstep) {
+					int m = n + jmax;
+
+					Lanes datam1_r = get(data, m);
+					Lanes datam1_i = get(data, m + 1);
+					Lanes datan1_r = get(data, n);
+					Lanes datan1_i = get(data, n + 1);
+
+					n += nnstep;
+					m += nnstep;
+					Lanes datam2_r = get(data, m);
+					Lanes datam2_i = get(data, m + 1);
+					Lanes datan2_r = get(data, n);
+					Lanes datan2_i = get(data, n + 1);
+
+					Lanes tempr = datam1_r;
+					Lanes tempi = datam1_i;
+
+					datam1_r = datan1_r - tempr;
+					datam1_i = datan1_i - tempi;
+					datan1_r = datan1_r + tempr;
+					datan1_i = datan1_i + tempi;
+
+					Lanes n2w1r = datan2_r;
+					Lanes n2w1i = datan2_i;
+					Lanes m2ww1r = datam2_r;
+					Lanes m2ww1i = datam2_i;
+
+					tempr = m2ww1r - n2w1r;
+					tempi = m2ww1i - n2w1i;
+
+					datam2_r = datam1_r + tempi;
+					datam2_i = datam1_i - tempr;
+					datam1_r = datam1_r - tempi;
+					datam1_i = datam1_i + tempr;
+
+					tempr = n2w1r + m2ww1r;
+					tempi = n2w1i + m2ww1i;
+
+					datan2_r = datan1_r - tempr;
+					datan2_i = datan1_i - tempi;
+					datan1_r = datan1_r + tempr;
+					datan1_i = datan1_i + tempi;
+
+					set(data, m, datam2_r);
+					set(data, m + 1, datam2_i);
+					set(data, n, datan2_r);
+					set(data, n + 1, datan2_i);
+
+					n -= nnstep;
+					m -= nnstep;
+					set(data, m, datam1_r);
+					set(data, m + 1, datam1_i);
+					set(data, n, datan1_r);
+					set(data, n + 1, datan1_i);
+				}
+			}
+
+			for (int j = 2; j < jmax; j += 2) {
+				Lanes wr = Lanes::broadcast(w[i++]);
+				Lanes wi = Lanes::broadcast(w[i++]);
+				Lanes wr1 = Lanes::broadcast(w[ii++]);
+				Lanes wi1 = Lanes::broadcast(w[ii++]);
+				Lanes wwr1 = Lanes::broadcast(w[iii++]);
+				Lanes wwi1 = Lanes::broadcast(w[iii++]);
+
+				for (int n = j; n < fftFrameSize2; n += nstep) {
+					int m = n + jmax;
+
+					Lanes datam1_r = get(data, m);
+					Lanes datam1_i = get(data, m + 1);
+					Lanes datan1_r = get(data, n);
+					Lanes datan1_i = get(data, n + 1);
+
+					n += nnstep;
+					m += nnstep;
+					Lanes datam2_r = get(data, m);
+					Lanes datam2_i = get(data, m + 1);
+					Lanes datan2_r = get(data, n);
+					Lanes datan2_i = get(data, n + 1);
+
+					Lanes tempr = datam1_r * wr - datam1_i * wi;
+					Lanes tempi = datam1_r * wi + datam1_i * wr;
+
+					datam1_r = datan1_r - tempr;
+					datam1_i = datan1_i - tempi;
+					datan1_r = datan1_r + tempr;
+					datan1_i = datan1_i + tempi;
+
+					Lanes n2w1r = datan2_r * wr1 - datan2_i * wi1;
+					Lanes n2w1i = datan2_r * wi1 + datan2_i * wr1;
+					Lanes m2ww1r = datam2_r * wwr1 - datam2_i * wwi1;
+					Lanes m2ww1i = datam2_r * wwi1 + datam2_i * wwr1;
+
+					tempr = m2ww1r - n2w1r;
+					tempi = m2ww1i - n2w1i;
+
+					datam2_r = datam1_r + tempi;
+					datam2_i = datam1_i - tempr;
+					datam1_r = datam1_r - tempi;
+					datam1_i = datam1_i + tempr;
+
+					tempr = n2w1r + m2ww1r;
+					tempi = n2w1i + m2ww1i;
+
+					datan2_r = datan1_r - tempr;
+					datan2_i = datan1_i - tempi;
+					datan1_r = datan1_r + tempr;
+					datan1_i = datan1_i + tempi;
+
+					set(data, m, datam2_r);
+					set(data, m + 1, datam2_i);
+					set(data, n, datan2_r);
+					set(data, n + 1, datan2_i);
+
+					n -= nnstep;
+					m -= nnstep;
+					set(data, m, datam1_r);
+					set(data, m + 1, datam1_i);
+					set(data, n, datan1_r);
+					set(data, n + 1, datan1_i);
+				}
+			}
+
+			i += jmax << 1;
+		}
+
+		calcF2E(fftFrameSize, data, i, nstep, w);
+	}
+
+	// Perform Factor-4 Decomposition with 3 * complex operators and 8 +/- complex operators
+	static void calcF4FE(int fftFrameSize, float *data, int i, int nstep, const float *w, int w_len)
+	{
+		int fftFrameSize2 = fftFrameSize << 1;
+		// Factor-4 Decomposition
+
+		while (nstep < fftFrameSize2) {
+
+			int jmax = nstep;
+			int nnstep = nstep << 1;
+			if (nnstep == fftFrameSize2) {
+				// Factor-4 Decomposition not possible
+				calcF2E(fftFrameSize, data, i, nstep, w);
+				return;
+			}
+			nstep <<= 2;
+			int ii = i + jmax;
+			int iii = i + w_len;
+			for (int n = 0; n < jmax; n += 2) {
+				Lanes wr = Lanes::broadcast(w[i++]);
+				Lanes wi = Lanes::broadcast(w[i++]);
+				Lanes wr1 = Lanes::broadcast(w[ii++]);
+				Lanes wi1 = Lanes::broadcast(w[ii++]);
+				Lanes wwr1 = Lanes::broadcast(w[iii++]);
+				Lanes wwi1 = Lanes::broadcast(w[iii++]);
+
+				int m = n + jmax;
+
+				Lanes datam1_r = get(data, m);
+				Lanes datam1_i = get(data, m + 1);
+				Lanes datan1_r = get(data, n);
+				Lanes datan1_i = get(data, n + 1);
+
+				n += nnstep;
+				m += nnstep;
+				Lanes datam2_r = get(data, m);
+				Lanes datam2_i = get(data, m + 1);
+				Lanes datan2_r = get(data, n);
+				Lanes datan2_i = get(data, n + 1);
+
+				Lanes tempr = datam1_r * wr - datam1_i * wi;
+				Lanes tempi = datam1_r * wi + datam1_i * wr;
+
+				datam1_r = datan1_r - tempr;
+				datam1_i = datan1_i - tempi;
+				datan1_r = datan1_r + tempr;
+				datan1_i = datan1_i + tempi;
+
+				Lanes n2w1r = datan2_r * wr1 - datan2_i * wi1;
+				Lanes n2w1i = datan2_r * wi1 + datan2_i * wr1;
+				Lanes m2ww1r = datam2_r * wwr1 - datam2_i * wwi1;
+				Lanes m2ww1i = datam2_r * wwi1 + datam2_i * wwr1;
+
+				tempr = m2ww1r - n2w1r;
+				tempi = m2ww1i - n2w1i;
+
+				datam2_r = datam1_r + tempi;
+				datam2_i = datam1_i - tempr;
+				datam1_r = datam1_r - tempi;
+				datam1_i = datam1_i + tempr;
+
+				tempr = n2w1r + m2ww1r;
+				tempi = n2w1i + m2ww1i;
+
+				datan2_r = datan1_r - tempr;
+				datan2_i = datan1_i - tempi;
+				datan1_r = datan1_r + tempr;
+				datan1_i = datan1_i + tempi;
+
+				set(data, m, datam2_r);
+				set(data, m + 1, datam2_i);
+				set(data, n, datan2_r);
+				set(data, n + 1, datan2_i);
+
+				n -= nnstep;
+				m -= nnstep;
+				set(data, m, datam1_r);
+				set(data, m + 1, datam1_i);
+				set(data, n, datan1_r);
+				set(data, n + 1, datan1_i);
+			}
+
+			i += jmax << 1;
+		}
+	}
+
+	static void bitreversal(const FastFourierTransformPlan &plan, float *data)
+	{
+		int fftFrameSize = plan.fftFrameSize;
+
+		// safety check
+		if (fftFrameSize < 4) {
+			return;
+		}
+
+		const int *bitm_array = plan.bitm_array.data();
+		int inverse = (plan.fftFrameSize2 - 2);
+		for (int i = 0; i < fftFrameSize; i += 4) {
+			int j = bitm_array[i];
+
+			// Performing Bit-Reversal, even v.s. even, O(2N)
+			if (i < j) {
+				// COMPLEX: SWAP(data[n], data[m])
+				swap(data, i, j);
+				swap(data, i + 1, j + 1);
+
+				int n = inverse - i;
+				int m = inverse - j;
+				swap(data, n, m);
+				swap(data, n + 1, m + 1);
+			}
+
+			// Performing Bit-Reversal, odd v.s. even, O(N)
+			int m = j + fftFrameSize; // bitm_array[i+2];
+			int n = i + 2;
+			swap(data, n, m);
+			swap(data, n + 1, m + 1);
+		}
+	}
+
+};
+
+#endif /* FASTFOURIERTRANSFORMKERNEL_H */
@@ -0,0 +1,154 @@
+//
+//  FastFourierTransformPlan.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <math.h>
+#include <map>
+#include <mutex>
+#include "FastFourierTransformPlan.h"
+
+using std::map;
+using std::mutex;
+using std::lock_guard;
+
+
+// MARK: Static
+
+shared_ptr<const FastFourierTransformPlan> FastFourierTransformPlan::get(int numberOfSamples)
+{
+	static mutex cacheMutex;
+	static map<int, shared_ptr<const FastFourierTransformPlan>> cache;
+
+	lock_guard<mutex> lock(cacheMutex);
+
+	shared_ptr<const FastFourierTransformPlan> &plan = cache[numberOfSamples];
+	if (plan == nullptr) {
+		plan = std::make_shared<const FastFourierTransformPlan>(numberOfSamples);
+	}
+
+	return plan;
+}
+
+// MARK: -
+
+FastFourierTransformPlan::FastFourierTransformPlan(int numberOfSamples) : numberOfSamples(numberOfSamples)
+{
+	fftFrameSize = (numberOfSamples / 2);
+	fftFrameSize2 = (fftFrameSize << 1);
+
+#if __APPLE__
+	// ios accelerated fft
+	log2n = (vDSP_Length)log2f((float)fftFrameSize);
+	fftSetup = vDSP_create_fftsetup(log2n, FFT_RADIX2);
+#endif // __APPLE__
+
+	// java fft
+	w = computeTwiddleFactors(fftFrameSize);
+
+	// Pre-process Bit-Reversal
+	bitm_array.resize(fftFrameSize2);
+
+	for (int i = 2; i < fftFrameSize2; i += 2) {
+		int j = 0;
+		for (int bitm = 2; bitm < fftFrameSize2; bitm <<= 1) {
+			if ((i & bitm) != 0) {
+				j++;
+			}
+			j <<= 1;
+		}
+		bitm_array[i] = j;
+	}
+}
+
+FastFourierTransformPlan::~FastFourierTransformPlan()
+{
+#if __APPLE__
+	if (fftSetup != nil) {
+		vDSP_destroy_fftsetup(fftSetup);
+		fftSetup = nil;
+	}
+#endif // __APPLE__
+}
+
+// MARK: -
+// MARK: Private
+
+/*
+ * Twiddle factors of the Fast Fourier Transformer.
+ *
+ * @author Karl Helgason
+ *
+ * Copyright 2007 Sun Microsystems, Inc. All Rights Reserved. DO NOT ALTER
+ * OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER. This code is free
+ * software; you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License version 2 only, as published by the Free
+ * Software Foundation. Sun designates this particular file as subject to
+ * the "Classpath" exception as provided by Sun in the LICENSE file that
+ * accompanied this code. This code is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License version 2 for more details (a copy is included in the
+ * LICENSE file that accompanied this code). You should have received a copy
+ * of the GNU General Public License version 2 along with this work; if not,
+ * write to the Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301 USA. Please contact Sun Microsystems, Inc., 4150
+ * Network Circle, Santa Clara, CA 95054 USA or visit www.sun.com if you
+ * need additional information or have any questions.
+ */
+
+vector<float> FastFourierTransformPlan::computeTwiddleFactors(int fftFrameSize)
+{
+	int imax = (int)(logf(fftFrameSize) / logf(2.0f));
+
+	vector<float> warray((fftFrameSize - 1) * 4);
+	int w_index = 0;
+
+	for (int i = 0, nstep = 2; i < imax; i++) {
+		int jmax = nstep;
+		nstep <<= 1;
+
+		float wr = 1.0f;
+		float wi = 0.0f;
+
+		float arg = M_PI / (jmax >> 1);
+		float wfr = cosf(arg);
+		float wfi = -1.0f * sinf(arg);
+
+		for (int j = 0; j < jmax; j += 2) {
+			warray[w_index++] = wr;
+			warray[w_index++] = wi;
+
+			float tempr = wr;
+			wr = tempr * wfr - wi * wfi;
+			wi = tempr * wfi + wi * wfr;
+		}
+	}
+
+	// PRECOMPUTATION of wwr1, wwi1 for factor 4 Decomposition (3 * complex
+	// operators and 8 +/- complex operators)
+	{
+		w_index = 0;
+		int w_index2 = ((int)warray.size() >> 1);
+		for (int i = 0, nstep = 2; i < (imax - 1); i++) {
+			int jmax = nstep;
+			nstep *= 2;
+
+			int ii = w_index + jmax;
+			for (int j = 0; j < jmax; j += 2) {
+				float wr = warray[w_index++];
+				float wi = warray[w_index++];
+				float wr1 = warray[ii++];
+				float wi1 = warray[ii++];
+				warray[w_index2++] = wr * wr1 - wi * wi1;
+				warray[w_index2++] = wr * wi1 + wi * wr1;
+			}
+		}
+	}
+
+	return warray;
+}
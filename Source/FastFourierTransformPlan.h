@@ -0,0 +1,57 @@
+//
+//  FastFourierTransformPlan.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMPLAN_H
+#define FASTFOURIERTRANSFORMPLAN_H
+
+#if __APPLE__
+#include <Accelerate/Accelerate.h>
+#endif // __APPLE
+
+#include <memory>
+#include <vector>
+
+using std::shared_ptr;
+using std::vector;
+
+// The immutable part of a fast fourier transform of a given size (twiddle factors and
+// bit-reversal table). Plans are shared process-wide and may be used from any thread.
+class FastFourierTransformPlan {
+
+public:
+
+	// get the shared plan for the number of samples, creating it on first use
+	static shared_ptr<const FastFourierTransformPlan> get(int numberOfSamples);
+
+	FastFourierTransformPlan(int numberOfSamples);
+	~FastFourierTransformPlan();
+
+	FastFourierTransformPlan(const FastFourierTransformPlan&) = delete;
+	FastFourierTransformPlan& operator=(const FastFourierTransformPlan&) = delete;
+
+	int numberOfSamples { 0 };
+	int fftFrameSize { 0 };
+	int fftFrameSize2 { 0 };
+
+#if __APPLE__
+	// ios accelerated fft
+	vDSP_Length log2n { 0 };
+	FFTSetup fftSetup { nil };
+#endif // __APPLE__
+
+	// java fft
+	vector<int> bitm_array;
+	vector<float> w;
+
+private:
+
+	static vector<float> computeTwiddleFactors(int fftFrameSize);
+
+};
+
+#endif /* FASTFOURIERTRANSFORMPLAN_H */
@@ -0,0 +1,105 @@
+//
+//  FastFourierTransformSIMD.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FastFourierTransformSIMD.h"
+#include "FastFourierTransformKernel.h"
+#include "FloatLanes.h"
+#include "FloatLanesSIMD.h"
+
+
+namespace {
+
+// MARK: Scalar
+
+typedef FastFourierTransformKernel<FloatLanes<4>> ScalarKernel;
+
+const FastFourierTransformSIMD scalarSIMD = {
+	FastFourierTransformInstructionSet::scalar, 4, &ScalarKernel::transform, &ScalarKernel::magnitudes
+};
+
+// MARK: -
+// MARK: SSE
+
+#if defined(__SSE2__)
+
+typedef FastFourierTransformKernel<FloatLanesSSE> SSEKernel;
+
+const FastFourierTransformSIMD sseSIMD = {
+	FastFourierTransformInstructionSet::sse, FloatLanesSSE::numLanes, &SSEKernel::transform, &SSEKernel::magnitudes
+};
+
+#endif // __SSE2__
+
+// MARK: -
+// MARK: NEON
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+typedef FastFourierTransformKernel<FloatLanesNEON> NEONKernel;
+
+const FastFourierTransformSIMD neonSIMD = {
+	FastFourierTransformInstructionSet::neon, FloatLanesNEON::numLanes, &NEONKernel::transform, &NEONKernel::magnitudes
+};
+
+#endif // __ARM_NEON && __aarch64__
+
+}
+
+// MARK: -
+
+const FastFourierTransformSIMD *FastFourierTransformSIMD::get(FastFourierTransformInstructionSet instructionSet)
+{
+	switch (instructionSet) {
+
+		case FastFourierTransformInstructionSet::scalar:
+			return &scalarSIMD;
+
+		case FastFourierTransformInstructionSet::sse:
+#if defined(__SSE2__)
+			return &sseSIMD;
+#else
+			return NULL;
+#endif // __SSE2__
+
+		case FastFourierTransformInstructionSet::avx2:
+			return getFastFourierTransformAVX2();
+
+		case FastFourierTransformInstructionSet::neon:
+#if defined(__ARM_NEON) && defined(__aarch64__)
+			return &neonSIMD;
+#else
+			return NULL;
+#endif // __ARM_NEON && __aarch64__
+
+	}
+
+	return NULL;
+}
+
+const FastFourierTransformSIMD &FastFourierTransformSIMD::getBest()
+{
+	static const FastFourierTransformSIMD *best = []() {
+		const FastFourierTransformInstructionSet preferred[] = {
+			FastFourierTransformInstructionSet::avx2,
+			FastFourierTransformInstructionSet::neon,
+			FastFourierTransformInstructionSet::sse
+		};
+
+		for (auto instructionSet : preferred) {
+			const FastFourierTransformSIMD *simd = get(instructionSet);
+			if (simd != NULL) {
+				return simd;
+			}
+		}
+
+		return &scalarSIMD;
+	}();
+
+	return *best;
+}
@@ -0,0 +1,42 @@
+//
+//  FastFourierTransformSIMD.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FASTFOURIERTRANSFORMSIMD_H
+#define FASTFOURIERTRANSFORMSIMD_H
+
+#include "FastFourierTransformPlan.h"
+
+enum class FastFourierTransformInstructionSet {
+	scalar,
+	sse,
+	avx2,
+	neon
+};
+
+// The batched java fft kernel compiled for one instruction set. The frames are interleaved
+// numLanes at a time (see FastFourierTransformKernel).
+struct FastFourierTransformSIMD {
+
+	FastFourierTransformInstructionSet instructionSet;
+	int numLanes;
+
+	void (*transform)(const FastFourierTransformPlan &plan, float *data);
+	void (*magnitudes)(const FastFourierTransformPlan &plan, const float *data, float *outFFTData);
+
+	// the kernel for the instruction set, or NULL if it is not supported by this build or cpu
+	static const FastFourierTransformSIMD *get(FastFourierTransformInstructionSet instructionSet);
+
+	// the fastest kernel supported by the cpu (detected once at runtime)
+	static const FastFourierTransformSIMD &getBest();
+
+};
+
+// defined in FastFourierTransformAVX2.cpp (NULL when not building for x86)
+const FastFourierTransformSIMD *getFastFourierTransformAVX2();
+
+#endif /* FASTFOURIERTRANSFORMSIMD_H */
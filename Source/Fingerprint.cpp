@@ -7,44 +7,231 @@
 //
 
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include "Fingerprint.h"
+#include "FingerprintBatchExtractor.h"
+#include "FingerprintFormat.h"
 #include "FingerprintManager.h"
+#include "FingerprintPoints.h"
+#include "FingerprintStreamExtractor.h"
 #include "FingerprintSimilarityComputer.h"
+#include "MappedPairHashIndex.h"
+#include "PairHashIndex.h"
+#include "PairPositionTable.h"
+
+using std::lock_guard;
+using std::mutex;
+using std::unique_ptr;
+
+
+struct FingerprintDecoded {
+
+	FingerprintPoints points;
+
+};
+
+struct FingerprintIndex {
+
+	PairHashIndex index;
+	unique_ptr<MappedPairHashIndex> mappedIndex;	// index files
+
+	inline const PairHashIndexReader &getReader() const
+	{
+		if (mappedIndex) {
+			return *mappedIndex;
+		}
+		return index;
+	}
+
+};
+
+struct FingerprintPairTable {
+
+	PairPositionTable table;
+
+	FingerprintPairTable(const FingerprintView &fingerprint) : table(fingerprint)
+	{
+	}
+
+};
+
+struct FingerprintStream {
+
+	FingerprintStreamExtractor extractor;
+
+	FingerprintStream(SpectrogramNormalizationType normalization) : extractor(normalization)
+	{
+	}
+
+};
+
+
+// the batch extractor (created on the first batch)
+static mutex batchMutex;
+static unique_ptr<FingerprintBatchExtractor> batchExtractor;
+static int numBatchThreads = 0;
+
+
+static SpectrogramNormalizationType getNormalizationType(FingerprintNormalization normalization)
+{
+	switch (normalization) {
+		case FingerprintNormalizationRunning:
+			return SpectrogramNormalizationType::running;
+		case FingerprintNormalizationWindowed:
+			return SpectrogramNormalizationType::windowed;
+		case FingerprintNormalizationFixedReference:
+			return SpectrogramNormalizationType::fixedReference;
+		default:
+			return SpectrogramNormalizationType::global;
+	}
+}
+
+static Fingerprint *createFingerprint(const vector<uint8_t> &fingerprintData)
+{
+	Fingerprint *fingerprint = (Fingerprint*)malloc(sizeof(Fingerprint));
+	fingerprint->dataSize = (int)fingerprintData.size();
+	fingerprint->data = (uint8_t*)malloc(fingerprint->dataSize);
+	memcpy(fingerprint->data, fingerprintData.data(), fingerprint->dataSize);
+
+	return fingerprint;
+}
+
+// the fingerprint data in the version 1 format
+static vector<uint8_t> getFingerprintData(const Fingerprint *fingerprint)
+{
+	vector<uint8_t> fingerprintData;
+
+	if (FingerprintFormat::isCompact(fingerprint->data, fingerprint->dataSize)) {
+		if (!FingerprintFormat::decodeCompact(fingerprint->data, fingerprint->dataSize, fingerprintData)) {
+			fingerprintData.clear();
+		}
+	} else {
+		fingerprintData.assign(fingerprint->data, (fingerprint->data + fingerprint->dataSize));
+	}
+
+	return fingerprintData;
+}
 
 
 FingerprintSimilarity CompareFingerprints(const Fingerprint *fingerprint1, const Fingerprint *fingerprint2)
+{
+	// decode the fingerprints (compact fingerprints are expanded)
+	FingerprintDecoded decoded1;
+	FingerprintDecoded decoded2;
+	if (!decoded1.points.decode(fingerprint1->data, fingerprint1->dataSize) || !decoded2.points.decode(fingerprint2->data, fingerprint2->dataSize)) {
+		// no matches
+		return FingerprintSimilarityComputer::getSimilarity(OffsetHistogram(), 1);
+	}
+
+	return CompareDecodedFingerprints(&decoded1, &decoded2);
+}
+
+FingerprintSimilarity CompareDecodedFingerprints(const FingerprintDecoded *fingerprint1, const FingerprintDecoded *fingerprint2)
 {
 	// select the smaller fingerprint size
-	size_t dataSize = (fingerprint1->dataSize > fingerprint2->dataSize) ? fingerprint2->dataSize : fingerprint1->dataSize;
+	int numPoints = std::min(fingerprint1->points.getNumPoints(), fingerprint2->points.getNumPoints());
 
-	// copy the fingerprint data
-	vector<uint8_t> data1(dataSize);
-	memcpy(data1.data(), fingerprint1->data, dataSize);
-	vector<uint8_t> data2(dataSize);
-	memcpy(data2.data(), fingerprint2->data, dataSize);
+	FingerprintView view1(fingerprint1->points, numPoints);
+	FingerprintView view2(fingerprint2->points, numPoints);
 
-	FingerprintSimilarityComputer computer(data1, data2);
+	FingerprintSimilarityComputer computer(view1, view2);
 	return computer.getMatchResults();
 }
 
 Fingerprint *ExtractFingerprint(const int16_t *wave, int waveLength)
+{
+	return ExtractFingerprintWithNormalization(wave, waveLength, FingerprintNormalizationGlobal);
+}
+
+Fingerprint *ExtractFingerprintWithNormalization(const int16_t *wave, int waveLength, FingerprintNormalization normalization)
 {
 	// extract the fingerprint
 	FingerprintManager fingerprinter;
-	vector<uint8_t> *fingerprintData = fingerprinter.extractFingerprint(wave, waveLength);
+	vector<uint8_t> *fingerprintData = fingerprinter.extractFingerprint(wave, waveLength, getNormalizationType(normalization));
 	if (fingerprintData == NULL) {
 		return NULL;
 	}
 
 	// create the fingerprint
-	Fingerprint *fingerprint = (Fingerprint*)malloc(sizeof(Fingerprint));
-	fingerprint->dataSize = (int)fingerprintData->size();
-	fingerprint->data = (uint8_t*)malloc(fingerprint->dataSize);
-	memcpy(fingerprint->data, fingerprintData->data(), fingerprint->dataSize);
+	Fingerprint *fingerprint = createFingerprint(*fingerprintData);
+	delete fingerprintData;
 
 	return fingerprint;
 }
 
+int ExtractFingerprintBatch(const int16_t *const *waves, const int *waveLengths, int count, Fingerprint **fingerprints)
+{
+	return ExtractFingerprintBatchWithNormalization(waves, waveLengths, count, FingerprintNormalizationGlobal, fingerprints);
+}
+
+int ExtractFingerprintBatchWithNormalization(const int16_t *const *waves, const int *waveLengths, int count, FingerprintNormalization normalization, Fingerprint **fingerprints)
+{
+	if (count <= 0) {
+		return 0;
+	}
+
+	vector<vector<uint8_t>*> fingerprintData;
+	{
+		lock_guard<mutex> lock(batchMutex);
+		if (!batchExtractor) {
+			batchExtractor.reset(new FingerprintBatchExtractor(numBatchThreads));
+		}
+
+		batchExtractor->extract(waves, waveLengths, count, getNormalizationType(normalization), fingerprintData);
+	}
+
+	// create the fingerprints
+	int numFingerprints = 0;
+	for (int i = 0; i < count; i++) {
+		fingerprints[i] = NULL;
+		if (fingerprintData[i] != nullptr) {
+			fingerprints[i] = createFingerprint(*fingerprintData[i]);
+			delete fingerprintData[i];
+			numFingerprints += 1;
+		}
+	}
+
+	return numFingerprints;
+}
+
+Fingerprint *ExtractFingerprintParallel(const int16_t *wave, int waveLength)
+{
+	return ExtractFingerprintParallelWithNormalization(wave, waveLength, FingerprintNormalizationGlobal);
+}
+
+Fingerprint *ExtractFingerprintParallelWithNormalization(const int16_t *wave, int waveLength, FingerprintNormalization normalization)
+{
+	vector<uint8_t> *fingerprintData = nullptr;
+	{
+		lock_guard<mutex> lock(batchMutex);
+		if (!batchExtractor) {
+			batchExtractor.reset(new FingerprintBatchExtractor(numBatchThreads));
+		}
+
+		fingerprintData = batchExtractor->extractParallel(wave, waveLength, getNormalizationType(normalization));
+	}
+	if (fingerprintData == NULL) {
+		return NULL;
+	}
+
+	// create the fingerprint
+	Fingerprint *fingerprint = createFingerprint(*fingerprintData);
+	delete fingerprintData;
+
+	return fingerprint;
+}
+
+void FingerprintSetBatchThreads(int numThreads)
+{
+	lock_guard<mutex> lock(batchMutex);
+	numBatchThreads = std::max(numThreads, 0);
+
+	// the pool is created again with the new size on the next batch
+	batchExtractor.reset();
+}
+
 Fingerprint *ExtractFingerprintFromRawFile(const char *filePath)
 {
 	// open the file
@@ -58,17 +245,21 @@ Fingerprint *ExtractFingerprintFromRawFile(const char *filePath)
 	int fileSize = (int)ftell(file);
 	rewind(file);
 	if ((fileSize <= 0) || ((fileSize & 0x1) != 0)) {
+		fclose(file);
 		return NULL;
 	}
 
 	// allocate the buffer
 	void *fileBuffer = malloc(fileSize);
 	if (fileBuffer == NULL) {
+		fclose(file);
 		return NULL;
 	}
 
 	// read the file
-	if (fread(fileBuffer, 1, fileSize, file) != fileSize) {
+	size_t readSize = fread(fileBuffer, 1, fileSize, file);
+	fclose(file);
+	if (readSize != (size_t)fileSize) {
 		free(fileBuffer);
 		return NULL;
 	}
@@ -96,3 +287,232 @@ void FingerprintFree(Fingerprint *fingerprint)
 		free(fingerprint);
 	}
 }
+
+// MARK: -
+
+Fingerprint *FingerprintEncodeCompact(const Fingerprint *fingerprint, int intensityBits)
+{
+	if (fingerprint == NULL) {
+		return NULL;
+	}
+
+	if (intensityBits <= 0) {
+		intensityBits = FingerprintFormat::defaultIntensityBits;
+	}
+
+	// convert from the version 1 format
+	vector<uint8_t> fingerprintData = getFingerprintData(fingerprint);
+	return createFingerprint(FingerprintFormat::encodeCompact(fingerprintData.data(), (int)fingerprintData.size(), intensityBits));
+}
+
+Fingerprint *FingerprintDecodeCompact(const Fingerprint *fingerprint)
+{
+	if (fingerprint == NULL) {
+		return NULL;
+	}
+
+	vector<uint8_t> fingerprintData;
+	if (!FingerprintFormat::isCompact(fingerprint->data, fingerprint->dataSize)) {
+		// already in the version 1 format
+		fingerprintData.assign(fingerprint->data, (fingerprint->data + fingerprint->dataSize));
+	} else if (!FingerprintFormat::decodeCompact(fingerprint->data, fingerprint->dataSize, fingerprintData)) {
+		return NULL;
+	}
+
+	return createFingerprint(fingerprintData);
+}
+
+// MARK: -
+
+FingerprintDecoded *FingerprintDecode(const Fingerprint *fingerprint)
+{
+	if (fingerprint == NULL) {
+		return NULL;
+	}
+
+	FingerprintDecoded *decoded = new FingerprintDecoded;
+	if (!decoded->points.decode(fingerprint->data, fingerprint->dataSize)) {
+		delete decoded;
+		return NULL;
+	}
+
+	return decoded;
+}
+
+void FingerprintDecodedFree(FingerprintDecoded *fingerprint)
+{
+	delete fingerprint;
+}
+
+// MARK: -
+
+FingerprintPairTable *FingerprintPairTableCreate(const FingerprintDecoded *fingerprint)
+{
+	if (fingerprint == NULL) {
+		return NULL;
+	}
+
+	FingerprintView view(fingerprint->points, fingerprint->points.getNumPoints());
+	return new FingerprintPairTable(view);
+}
+
+FingerprintSimilarity CompareFingerprintPairTables(const FingerprintPairTable *table1, const FingerprintPairTable *table2)
+{
+	return FingerprintSimilarityComputer::getMatchResults(table1->table, table2->table);
+}
+
+int CompareFingerprintPairTablesWithAlignments(const FingerprintPairTable *table1, const FingerprintPairTable *table2, FingerprintAlignment *alignments, int maxAlignments)
+{
+	vector<FingerprintAlignment> results = FingerprintSimilarityComputer::getAlignments(table1->table, table2->table, maxAlignments);
+	std::copy(results.begin(), results.end(), alignments);
+
+	return (int)results.size();
+}
+
+void FingerprintPairTableFree(FingerprintPairTable *table)
+{
+	delete table;
+}
+
+// MARK: -
+
+FingerprintIndex *FingerprintIndexCreate(void)
+{
+	return new FingerprintIndex;
+}
+
+int FingerprintIndexAdd(FingerprintIndex *index, int referenceId, const Fingerprint *fingerprint)
+{
+	return FingerprintIndexAddFingerprints(index, &referenceId, &fingerprint, 1);
+}
+
+int FingerprintIndexAddFingerprints(FingerprintIndex *index, const int *referenceIds, const Fingerprint *const *fingerprints, int count)
+{
+	// index files are read-only
+	if (index->mappedIndex) {
+		return 0;
+	}
+
+	// decode the fingerprints, skipping the invalid ones
+	vector<FingerprintPoints> points(count);
+	vector<FingerprintView> views;
+	vector<int> ids;
+	views.reserve(count);
+	ids.reserve(count);
+
+	for (int i = 0; i < count; i++) {
+		if ((fingerprints[i] != NULL) && points[i].decode(fingerprints[i]->data, fingerprints[i]->dataSize)) {
+			views.push_back(FingerprintView(points[i]));
+			ids.push_back(referenceIds[i]);
+		}
+	}
+
+	return index->index.addReferences(ids.data(), views.data(), (int)views.size());
+}
+
+int FingerprintIndexQuery(const FingerprintIndex *index, const Fingerprint *fingerprint, FingerprintIndexMatch *matches, int maxMatches)
+{
+	FingerprintPoints points;
+	if ((fingerprint == NULL) || !points.decode(fingerprint->data, fingerprint->dataSize)) {
+		return 0;
+	}
+
+	vector<FingerprintIndexMatch> results = index->getReader().query(FingerprintView(points), maxMatches);
+	std::copy(results.begin(), results.end(), matches);
+
+	return (int)results.size();
+}
+
+FingerprintIndex *FingerprintIndexOpen(const char *filePath)
+{
+	MappedPairHashIndex *mappedIndex = MappedPairHashIndex::open(filePath);
+	if (mappedIndex == nullptr) {
+		return NULL;
+	}
+
+	FingerprintIndex *index = new FingerprintIndex;
+	index->mappedIndex.reset(mappedIndex);
+
+	return index;
+}
+
+int FingerprintIndexWrite(const FingerprintIndex *index, const char *filePath)
+{
+	// index files are written from the references added in memory
+	if (index->mappedIndex) {
+		return 0;
+	}
+
+	return (index->index.write(filePath) ? 1 : 0);
+}
+
+int FingerprintIndexGetNumReferences(const FingerprintIndex *index)
+{
+	return index->getReader().getNumReferences();
+}
+
+void FingerprintIndexFree(FingerprintIndex *index)
+{
+	delete index;
+}
+
+// MARK: -
+
+FingerprintStream *FingerprintStreamCreate(void)
+{
+	return FingerprintStreamCreateWithNormalization(FingerprintNormalizationRunning);
+}
+
+FingerprintStream *FingerprintStreamCreateWithNormalization(FingerprintNormalization normalization)
+{
+	return new FingerprintStream(getNormalizationType(normalization));
+}
+
+int FingerprintStreamPush(FingerprintStream *stream, const int16_t *wave, int waveLength)
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return stream->extractor.push(wave, waveLength);
+}
+
+Fingerprint *FingerprintStreamPull(FingerprintStream *stream)
+{
+	if (stream == NULL) {
+		return NULL;
+	}
+
+	// get the points of the completed frames
+	vector<uint8_t> fingerprintData;
+	stream->extractor.pull(fingerprintData);
+	if (fingerprintData.empty()) {
+		return NULL;
+	}
+
+	// create the fingerprint
+	return createFingerprint(fingerprintData);
+}
+
+int64_t FingerprintStreamGetPullStartFrame(const FingerprintStream *stream)
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return stream->extractor.getPullStartFrame();
+}
+
+int FingerprintStreamFlush(FingerprintStream *stream)
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return stream->extractor.flush();
+}
+
+void FingerprintStreamFree(FingerprintStream *stream)
+{
+	delete stream;
+}
@@ -9,6 +9,7 @@
 #ifndef FINGERPRINT_H
 #define FINGERPRINT_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -37,11 +38,104 @@ typedef struct FingerprintSimilarity {
 } FingerprintSimilarity;
 
 
+// one alignment (position offset) of two fingerprints
+typedef struct FingerprintAlignment {
+
+	int framePosition;				// the frame offset of the alignment
+	float startTime;				// the start time of the alignment
+	int numMatches;					// the number of features matched at exactly this offset
+	float score;					// the number of features matched per frame (including half of the neighboring offsets)
+	float similarity;				// similarity ranked in range (0.0 - 1.0)
+
+} FingerprintAlignment;
+
+
+// the amplitude range the spectrogram is normalized against
+typedef enum FingerprintNormalization {
+
+	FingerprintNormalizationGlobal = 0,		// the whole clip (default, not available for streams)
+	FingerprintNormalizationRunning,		// the audio so far
+	FingerprintNormalizationWindowed,		// the last 10 seconds of audio
+	FingerprintNormalizationFixedReference	// a fixed range for 16-bit audio
+
+} FingerprintNormalization;
+
+
+// (fingerprints that are not valid have no matches)
 FingerprintSimilarity CompareFingerprints(const Fingerprint *fingerprint1, const Fingerprint *fingerprint2);
 Fingerprint *ExtractFingerprint(const int16_t *wave, int waveLength);
+Fingerprint *ExtractFingerprintWithNormalization(const int16_t *wave, int waveLength, FingerprintNormalization normalization);
 Fingerprint *ExtractFingerprintFromRawFile(const char *filePath);
+
+// batch extraction across a thread pool, fingerprints[i] is the fingerprint of waves[i] (NULL if it failed)
+// returns the number of fingerprints extracted
+int ExtractFingerprintBatch(const int16_t *const *waves, const int *waveLengths, int count, Fingerprint **fingerprints);
+int ExtractFingerprintBatchWithNormalization(const int16_t *const *waves, const int *waveLengths, int count, FingerprintNormalization normalization, Fingerprint **fingerprints);
+
+// extraction of one long wave with its frames split across the batch thread pool (the same fingerprint as ExtractFingerprint)
+Fingerprint *ExtractFingerprintParallel(const int16_t *wave, int waveLength);
+Fingerprint *ExtractFingerprintParallelWithNormalization(const int16_t *wave, int waveLength, FingerprintNormalization normalization);
+
+// the number of threads of the batch and parallel extraction, 0 for one thread per core (the default)
+void FingerprintSetBatchThreads(int numThreads);
+
 void FingerprintFree(Fingerprint *fingerprint);
 
+// decoded fingerprints, for comparing a fingerprint many times without decoding it again
+typedef struct FingerprintDecoded FingerprintDecoded;
+
+FingerprintDecoded *FingerprintDecode(const Fingerprint *fingerprint);
+FingerprintSimilarity CompareDecodedFingerprints(const FingerprintDecoded *fingerprint1, const FingerprintDecoded *fingerprint2);
+void FingerprintDecodedFree(FingerprintDecoded *fingerprint);
+
+// precomputed pair tables, for comparing a fingerprint many times without pairing its points again
+// (tables cover the whole fingerprint, compare fingerprints with the same number of points for the same results as CompareFingerprints)
+typedef struct FingerprintPairTable FingerprintPairTable;
+
+FingerprintPairTable *FingerprintPairTableCreate(const FingerprintDecoded *fingerprint);
+FingerprintSimilarity CompareFingerprintPairTables(const FingerprintPairTable *table1, const FingerprintPairTable *table2);
+int CompareFingerprintPairTablesWithAlignments(const FingerprintPairTable *table1, const FingerprintPairTable *table2, FingerprintAlignment *alignments, int maxAlignments);
+void FingerprintPairTableFree(FingerprintPairTable *table);
+
+// inverted index of reference fingerprints, for finding the best matching references of a query
+// (matches have the similarity of CompareFingerprintPairTables with the reference as table1 and the query as table2)
+typedef struct FingerprintIndex FingerprintIndex;
+
+typedef struct FingerprintIndexMatch {
+
+	int referenceId;
+	FingerprintSimilarity similarity;
+
+} FingerprintIndexMatch;
+
+FingerprintIndex *FingerprintIndexCreate(void);
+// returns the number of references added (fingerprints that are not valid and reference ids already used are not added)
+int FingerprintIndexAdd(FingerprintIndex *index, int referenceId, const Fingerprint *fingerprint);
+int FingerprintIndexAddFingerprints(FingerprintIndex *index, const int *referenceIds, const Fingerprint *const *fingerprints, int count);
+int FingerprintIndexQuery(const FingerprintIndex *index, const Fingerprint *fingerprint, FingerprintIndexMatch *matches, int maxMatches);
+int FingerprintIndexGetNumReferences(const FingerprintIndex *index);
+void FingerprintIndexFree(FingerprintIndex *index);
+
+// index files, memory mapped read-only by FingerprintIndexOpen (pages are shared between processes)
+FingerprintIndex *FingerprintIndexOpen(const char *filePath);
+int FingerprintIndexWrite(const FingerprintIndex *index, const char *filePath);
+
+// compact fingerprint format (version 2), intensityBits 1 - 31 (0 for the default of 10, 31 is lossless)
+Fingerprint *FingerprintEncodeCompact(const Fingerprint *fingerprint, int intensityBits);
+Fingerprint *FingerprintDecodeCompact(const Fingerprint *fingerprint);
+
+// streaming extraction
+// (a pulled fingerprint spans at most 65536 frames, its x-coordinates start at the frame of FingerprintStreamGetPullStartFrame)
+typedef struct FingerprintStream FingerprintStream;
+
+FingerprintStream *FingerprintStreamCreate(void);
+FingerprintStream *FingerprintStreamCreateWithNormalization(FingerprintNormalization normalization);
+int FingerprintStreamPush(FingerprintStream *stream, const int16_t *wave, int waveLength);
+Fingerprint *FingerprintStreamPull(FingerprintStream *stream);
+int64_t FingerprintStreamGetPullStartFrame(const FingerprintStream *stream);
+int FingerprintStreamFlush(FingerprintStream *stream);
+void FingerprintStreamFree(FingerprintStream *stream);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
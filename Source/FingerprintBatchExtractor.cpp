@@ -0,0 +1,38 @@
+//
+//  FingerprintBatchExtractor.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FingerprintBatchExtractor.h"
+
+
+FingerprintBatchExtractor::FingerprintBatchExtractor(int numThreads) : pool(numThreads)
+{
+	for (int i = 0; i < pool.getNumThreads(); i++) {
+		fingerprinters.push_back(unique_ptr<FingerprintManager>(new FingerprintManager));
+	}
+
+	parallelFingerprinter.setThreadPool(&pool);
+}
+
+void FingerprintBatchExtractor::extract(const int16_t *const *waves, const int *waveLengths, int count, SpectrogramNormalizationType normalization, vector<vector<uint8_t>*> &fingerprintData)
+{
+	fingerprintData.assign(count, nullptr);
+
+	pool.run(count, [&](int index, int worker) {
+		if ((waves[index] == nullptr) || (waveLengths[index] < 0)) {
+			return;
+		}
+
+		fingerprintData[index] = fingerprinters[worker]->extractFingerprint(waves[index], waveLengths[index], normalization);
+	});
+}
+
+vector<uint8_t> *FingerprintBatchExtractor::extractParallel(const int16_t *wave, int waveLength, SpectrogramNormalizationType normalization)
+{
+	return parallelFingerprinter.extractFingerprint(wave, waveLength, normalization);
+}
@@ -0,0 +1,52 @@
+//
+//  FingerprintBatchExtractor.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FINGERPRINTBATCHEXTRACTOR_H
+#define FINGERPRINTBATCHEXTRACTOR_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "FingerprintManager.h"
+#include "SpectrogramNormalizer.h"
+#include "ThreadPool.h"
+
+using std::unique_ptr;
+using std::vector;
+
+// Extracts the fingerprints of many clips across a thread pool.
+// Each worker keeps its own fingerprint manager (fft, window and spectrogram buffers)
+// for all the clips it extracts, the fingerprints are the same as serial extraction.
+// A long clip can also be extracted on its own with its frames split across the pool.
+class FingerprintBatchExtractor {
+
+public:
+
+	// numThreads 0 for one thread per core
+	FingerprintBatchExtractor(int numThreads);
+
+	inline int getNumThreads() const
+	{
+		return pool.getNumThreads();
+	}
+
+	// fingerprintData[i] is the fingerprint data of waves[i] (owned by the caller, nullptr if it failed)
+	void extract(const int16_t *const *waves, const int *waveLengths, int count, SpectrogramNormalizationType normalization, vector<vector<uint8_t>*> &fingerprintData);
+
+	// the fingerprint data of one wave with its frames split across the pool (owned by the caller, nullptr if it failed)
+	vector<uint8_t> *extractParallel(const int16_t *wave, int waveLength, SpectrogramNormalizationType normalization);
+
+private:
+
+	ThreadPool pool;
+	vector<unique_ptr<FingerprintManager>> fingerprinters;	// one per worker
+	FingerprintManager parallelFingerprinter;	// runs on the calling thread, using the pool
+
+};
+
+#endif /* FINGERPRINTBATCHEXTRACTOR_H */
@@ -0,0 +1,261 @@
+//
+//  FingerprintFormat.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include "FingerprintFormat.h"
+#include "FingerprintProperties.h"
+
+
+namespace {
+
+const uint8_t compactMagic[3] = { 'F', 'P', 'C' };
+const int headerSize = 6;	// magic, version, binBits, intensityBits
+
+// MARK: Bitstream
+
+class BitWriter {
+
+public:
+
+	vector<uint8_t> &data;
+
+	BitWriter(vector<uint8_t> &data) : data(data) { }
+
+	void write(uint32_t value, int numBits)
+	{
+		for (int b = (numBits - 1); b >= 0; b--) {
+			if (numPendingBits == 0) {
+				data.push_back(0);
+			}
+			data.back() |= (uint8_t)(((value >> b) & 0x1) << (7 - numPendingBits));
+			numPendingBits = ((numPendingBits + 1) & 0x7);
+		}
+	}
+
+	// signed exp-golomb: 0, 1, -1, 2, -2, ... are coded as 1, 010, 011, 00100, 00101, ...
+	void writeSignedExpGolomb(int value)
+	{
+		uint32_t codeNum = ((value > 0) ? ((uint32_t)value * 2 - 1) : ((uint32_t)(-(int64_t)value) * 2));
+		uint32_t code = (codeNum + 1);
+		int numBits = 0;
+		while ((code >> numBits) > 1) {
+			numBits += 1;
+		}
+		write(0, numBits);
+		write(code, (numBits + 1));
+	}
+
+private:
+
+	int numPendingBits { 0 };
+
+};
+
+class BitReader {
+
+public:
+
+	BitReader(const uint8_t *data, int dataSize) : data(data), numBits((int64_t)dataSize * 8) { }
+
+	bool read(int numBits, uint32_t &value)
+	{
+		if ((position + numBits) > this->numBits) {
+			return false;
+		}
+
+		value = 0;
+		for (int b = 0; b < numBits; b++) {
+			value = ((value << 1) | ((data[position >> 3] >> (7 - (position & 0x7))) & 0x1));
+			position += 1;
+		}
+
+		return true;
+	}
+
+	bool readSignedExpGolomb(int &value)
+	{
+		int numLeadingZeros = 0;
+		uint32_t bit = 0;
+		while (true) {
+			if (!read(1, bit)) {
+				return false;
+			}
+			if (bit != 0) {
+				break;
+			}
+			numLeadingZeros += 1;
+			if (numLeadingZeros > 31) {
+				return false;
+			}
+		}
+
+		uint32_t suffix = 0;
+		if (!read(numLeadingZeros, suffix)) {
+			return false;
+		}
+
+		uint32_t codeNum = (((uint32_t)1 << numLeadingZeros) - 1 + suffix);
+		value = ((codeNum & 0x1) ? (int)((codeNum + 1) / 2) : -(int)(codeNum / 2));
+		return true;
+	}
+
+private:
+
+	const uint8_t *data;
+	int64_t numBits;
+	int64_t position { 0 };
+
+};
+
+// MARK: -
+// MARK: Varint
+
+void writeVarint(vector<uint8_t> &data, uint32_t value)
+{
+	while (value >= 0x80) {
+		data.push_back((uint8_t)((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	data.push_back((uint8_t)value);
+}
+
+bool readVarint(const uint8_t *data, int dataSize, int &offset, uint32_t &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		if (offset >= dataSize) {
+			return false;
+		}
+		uint8_t byte = data[offset++];
+		value |= ((uint32_t)(byte & 0x7F) << shift);
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}
+
+// MARK: -
+
+bool FingerprintFormat::isCompact(const uint8_t *data, int dataSize)
+{
+	return ((data != NULL) && (dataSize >= headerSize) && (data[0] == compactMagic[0]) && (data[1] == compactMagic[1]) && (data[2] == compactMagic[2]));
+}
+
+vector<uint8_t> FingerprintFormat::encodeCompact(const uint8_t *data, int dataSize, int intensityBits)
+{
+	intensityBits = std::min(std::max(intensityBits, 1), 31);
+	int numPoints = (dataSize / 8);
+
+	// bits needed for the largest bin
+	int maxY = 0;
+	for (int i = 0; i < numPoints; i++) {
+		const uint8_t *point = data + (i * 8);
+		maxY = std::max(maxY, (((int)point[2] << 8) | (int)point[3]));
+	}
+
+	int binBits = 1;
+	while ((maxY >> binBits) != 0) {
+		binBits += 1;
+	}
+
+	// header
+	vector<uint8_t> compact;
+	compact.reserve(headerSize + 16 + (((size_t)numPoints * (binBits + intensityBits + 3)) / 8));
+	compact.insert(compact.end(), compactMagic, (compactMagic + 3));
+	compact.push_back((uint8_t)compactVersion);
+	compact.push_back((uint8_t)binBits);
+	compact.push_back((uint8_t)intensityBits);
+	writeVarint(compact, (uint32_t)FingerprintProperties::sampleSizePerFrame);
+	writeVarint(compact, (uint32_t)FingerprintProperties::overlapFactor);
+	writeVarint(compact, (uint32_t)FingerprintProperties::numRobustPointsPerFrame);
+	writeVarint(compact, (uint32_t)numPoints);
+
+	// points
+	BitWriter writer(compact);
+	int previousX = 0;
+
+	for (int i = 0; i < numPoints; i++) {
+		const uint8_t *point = data + (i * 8);
+		int x = (((int)point[0] << 8) | (int)point[1]);
+		int y = (((int)point[2] << 8) | (int)point[3]);
+		int intensity = (int)(((uint32_t)point[4] << 24) | ((uint32_t)point[5] << 16) | ((uint32_t)point[6] << 8) | (uint32_t)point[7]);
+
+		writer.writeSignedExpGolomb(x - previousX);
+		writer.write((uint32_t)y, binBits);
+		writer.write((uint32_t)std::max(intensity, 0) >> (31 - intensityBits), intensityBits);
+		previousX = x;
+	}
+
+	return compact;
+}
+
+bool FingerprintFormat::decodeCompact(const uint8_t *data, int dataSize, vector<uint8_t> &fingerprint)
+{
+	if (!isCompact(data, dataSize) || (data[3] != compactVersion)) {
+		return false;
+	}
+
+	int binBits = data[4];
+	int intensityBits = data[5];
+	if ((binBits < 1) || (binBits > 16) || (intensityBits < 1) || (intensityBits > 31)) {
+		return false;
+	}
+
+	// the parameters are informational, the points are decoded as they were extracted
+	int offset = headerSize;
+	uint32_t sampleSizePerFrame;
+	uint32_t overlapFactor;
+	uint32_t numRobustPointsPerFrame;
+	uint32_t numPoints;
+	if (!readVarint(data, dataSize, offset, sampleSizePerFrame) || !readVarint(data, dataSize, offset, overlapFactor) || !readVarint(data, dataSize, offset, numRobustPointsPerFrame) || !readVarint(data, dataSize, offset, numPoints)) {
+		return false;
+	}
+
+	// every point needs at least one bit for its x delta
+	BitReader reader((data + offset), (dataSize - offset));
+	if (((uint64_t)numPoints * (1 + binBits + intensityBits)) > ((uint64_t)(dataSize - offset) * 8)) {
+		return false;
+	}
+
+	fingerprint.clear();
+	fingerprint.reserve((size_t)numPoints * 8);
+	int x = 0;
+
+	for (uint32_t i = 0; i < numPoints; i++) {
+		int delta;
+		uint32_t y;
+		uint32_t intensity;
+		if (!reader.readSignedExpGolomb(delta) || !reader.read(binBits, y) || !reader.read(intensityBits, intensity)) {
+			return false;
+		}
+
+		x += delta;
+		if ((x < 0) || (x > 0xFFFF)) {
+			return false;
+		}
+
+		// the quantized intensity keeps its top bits
+		intensity <<= (31 - intensityBits);
+
+		fingerprint.push_back((uint8_t)((x >> 8) & 0xFF));
+		fingerprint.push_back((uint8_t)(x & 0xFF));
+		fingerprint.push_back((uint8_t)((y >> 8) & 0xFF));
+		fingerprint.push_back((uint8_t)(y & 0xFF));
+		fingerprint.push_back((uint8_t)((intensity >> 24) & 0xFF));
+		fingerprint.push_back((uint8_t)((intensity >> 16) & 0xFF));
+		fingerprint.push_back((uint8_t)((intensity >> 8) & 0xFF));
+		fingerprint.push_back((uint8_t)(intensity & 0xFF));
+	}
+
+	return true;
+}
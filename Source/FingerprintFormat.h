@@ -0,0 +1,48 @@
+//
+//  FingerprintFormat.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FINGERPRINTFORMAT_H
+#define FINGERPRINTFORMAT_H
+
+#include <stdint.h>
+#include <vector>
+
+using std::vector;
+
+// Fingerprint data formats.
+//
+// version 1: 8 bytes per point, big-endian (x: 2 bytes, y: 2 bytes, intensity: 4 bytes).
+//
+// version 2 (compact):
+//   'F' 'P' 'C' version     4 bytes, byte 2 can not be the high byte of a version 1 bin
+//   binBits                 1 byte, bits per bin
+//   intensityBits           1 byte, bits per intensity (the top bits of the 31 bit intensity)
+//   sampleSizePerFrame      varint (7 bits per byte, least significant first)
+//   overlapFactor           varint
+//   numRobustPointsPerFrame varint
+//   numPoints               varint
+//   points                  bitstream (most significant bit first), per point:
+//                           x delta (signed exp-golomb), y (binBits), intensity (intensityBits)
+class FingerprintFormat {
+
+public:
+
+	static const int compactVersion = 2;
+	static const int defaultIntensityBits = 10;
+
+	static bool isCompact(const uint8_t *data, int dataSize);
+
+	// version 1 to version 2, intensityBits 1 - 31 (31 is lossless)
+	static vector<uint8_t> encodeCompact(const uint8_t *data, int dataSize, int intensityBits);
+
+	// version 2 to version 1, returns false if the data is not a valid compact fingerprint
+	static bool decodeCompact(const uint8_t *data, int dataSize, vector<uint8_t> &fingerprint);
+
+};
+
+#endif /* FINGERPRINTFORMAT_H */
@@ -7,97 +7,76 @@
 //
 
 
-#include "ArrayCoord.h"
+#include <algorithm>
 #include "FingerprintManager.h"
 #include "FingerprintProperties.h"
 #include "RobustIntensityProcessor.h"
 #include "Spectrogram.h"
+#include "ThreadPool.h"
 
 // MARK: Static
 
-int FingerprintManager::getNumFrames(const vector<uint8_t> &fingerprint)
+void FingerprintManager::appendPoint(vector<uint8_t> &fingerprint, int x, int y, float intensityFloat)
 {
-	// safety check
-	if (fingerprint.size() < 8) {
-		return 0;
-	}
-
-	// get the last x-coordinate (length - 8 & length - 7) bytes from fingerprint
-	int numFrames = (((int)(fingerprint[fingerprint.size() - 8] & 0xFF) << 8) | (int)(fingerprint[fingerprint.size() - 7] & 0xFF)) + 1;
-
-	return numFrames;
+	// x-coordinate (2 byte integer)
+	fingerprint.push_back((uint8_t)((x >> 8) & 0xFF));
+	fingerprint.push_back((uint8_t)(x & 0xFF));
+
+	// y-coordinate (2 byte integer)
+	fingerprint.push_back((uint8_t)((y >> 8) & 0xFF));
+	fingerprint.push_back((uint8_t)(y & 0xFF));
+
+	// intensity (4 byte integer)
+	double integerMax = (double)0x7FFFFFFF;
+	double intensityDouble = ((double)intensityFloat * integerMax);
+	int intensity = (int)intensityDouble;
+	fingerprint.push_back((uint8_t)((intensity >> 24) & 0xFF));
+	fingerprint.push_back((uint8_t)((intensity >> 16) & 0xFF));
+	fingerprint.push_back((uint8_t)((intensity >> 8) & 0xFF));
+	fingerprint.push_back((uint8_t)(intensity & 0xFF));
 }
 
 // MARK: -
 // MARK: Public
 
-vector<uint8_t> *FingerprintManager::extractFingerprint(const int16_t *wave, int waveLength)
+void FingerprintManager::setThreadPool(ThreadPool *pool)
 {
-	// TODO: remove this copy
+	this->pool = pool;
 
-	// copy the wave data
-	vector<int16_t> resampledWave;
-	resampledWave.resize(waveLength);
-	memcpy(resampledWave.data(), wave, (waveLength * sizeof(int16_t)));
-
-	// ----
+	if (spectrogram) {
+		spectrogram->setThreadPool(pool);
+	}
+}
 
-	int numRobustPointsPerFrame = FingerprintProperties::numRobustPointsPerFrame;
+vector<uint8_t> *FingerprintManager::extractFingerprint(const int16_t *wave, int waveLength, SpectrogramNormalizationType normalization)
+{
 	int overlapFactor = FingerprintProperties::overlapFactor;
 	int sampleSizePerFrame = FingerprintProperties::sampleSizePerFrame;
 
 	// get the spectrogram data
-	Spectrogram spectrogram(resampledWave, sampleSizePerFrame, overlapFactor);
-	const vector<vector<float>> &spectrogramData = spectrogram.getNormalizedSpectrogramData();
-
-	// get the robust point list
-	vector<vector<int>> pointsLists = getRobustPointList(spectrogramData);
-	int numFrames = (int)pointsLists.size();
-
-	// prepare fingerprint bytes
-	vector<vector<int>> coordinates(numFrames);
-	for (int x = 0; x < numFrames; x++) {
-		coordinates[x].resize(numRobustPointsPerFrame);
+	if (!spectrogram || (spectrogram->getNormalization() != normalization)) {
+		spectrogram.reset(new Spectrogram(sampleSizePerFrame, overlapFactor, normalization));
+		spectrogram->setThreadPool(pool);
 	}
+	spectrogram->build(wave, waveLength);
+	const MatrixFloat &spectrogramData = spectrogram->getNormalizedSpectrogramData();
 
-	for (int x = 0; x < numFrames; x++) {
-		if (pointsLists[x].size() == numRobustPointsPerFrame) {
-			for (int y = 0; y < numRobustPointsPerFrame; y++) {
-				coordinates[x][y] = pointsLists[x][y];
-			}
-		} else {
-			// use -1 to fill the empty byte
-			for (int y = 0; y < numRobustPointsPerFrame; y++) {
-				coordinates[x][y] = -1;
-			}
-		}
-	}
+	int numFrames = spectrogramData.getNumRows();
+
+	// get the robust points, coordinates[x * numRobustPointsPerFrame + n] = y
+	vector<int> coordinates;
+	getRobustPoints(spectrogramData, coordinates);
 
 	// build the fingerprint data
 	vector<uint8_t> *fingerprintData = new vector<uint8_t>;
+	fingerprintData->reserve((size_t)numFrames * numRobustPointsPerFrame * 8);
 
 	for (int i = 0; i < numFrames; i++) {
+		const int *frameCoordinates = &coordinates[(size_t)i * numRobustPointsPerFrame];
 		for (int j = 0; j < numRobustPointsPerFrame; j++) {
-			if (coordinates[i][j] != -1) {
-				// x-coordinate (2 byte integer)
-				int x = i;
-				fingerprintData->push_back((uint8_t)((x >> 8) & 0xFF));
-				fingerprintData->push_back((uint8_t)(x & 0xFF));
-
-				// y-coordinate (2 byte integer)
-				int y = coordinates[i][j];
-				fingerprintData->push_back((uint8_t)((y >> 8) & 0xFF));
-				fingerprintData->push_back((uint8_t)(y & 0xFF));
-
-				// intensity (4 byte integer)
-				double integerMax = (double)0x7FFFFFFF;
-				float intensityFloat = spectrogramData[x][y];
-				double intensityDouble = ((double)intensityFloat * integerMax);
-				int intensity = (int)intensityDouble;
-				fingerprintData->push_back((uint8_t)((intensity >> 24) & 0xFF));
-				fingerprintData->push_back((uint8_t)((intensity >> 16) & 0xFF));
-				fingerprintData->push_back((uint8_t)((intensity >> 8) & 0xFF));
-				fingerprintData->push_back((uint8_t)(intensity & 0xFF));
+			int y = frameCoordinates[j];
+			if (y != -1) {
+				appendPoint(*fingerprintData, i, y, spectrogramData[i][y]);
 			}
 		}
 	}
@@ -105,63 +84,70 @@ vector<uint8_t> *FingerprintManager::extractFingerprint(const int16_t *wave, int
 	return fingerprintData;
 }
 
-// MARK: -
-// MARK: Private
-
-vector<vector<int>> FingerprintManager::getRobustPointList(const vector<vector<float>> &spectrogramData)
+bool FingerprintManager::getRobustFramePoints(const float *frame, int numFrequencyUnits, int *points)
 {
-	int numX = (int)spectrogramData.size();
-	int numY = (int)spectrogramData[0].size();
+	return getRobustFramePoints(frame, numFrequencyUnits, points, bankIndices);
+}
 
-	vector<vector<float>> allBanksIntensities(numX);
-	for (int x = 0; x < numX; x++) {
-		allBanksIntensities[x].resize(numY);
-	}
+void FingerprintManager::getRobustPoints(const MatrixFloat &spectrogramData, vector<int> &points)
+{
+	int numFrames = spectrogramData.getNumRows();
+	int numFrequencyUnits = spectrogramData.getNumColumns();
 
-	int bandwidthPerBank = (numY / numFilterBanks);
+	points.resize((size_t)numFrames * numRobustPointsPerFrame);
 
-	for (int b = 0; b < numFilterBanks; b++) {
-		vector<vector<float>> bankIntensities(numX);
-		for (int x = 0; x < numX; x++) {
-			bankIntensities[x].resize(bandwidthPerBank);
-		}
+	if ((pool != nullptr) && (pool->getNumThreads() > 1) && (numFrames > numFramesPerTask)) {
+		// the frames are independent, each worker selects the points of whole tasks
+		int numTasks = ((numFrames + numFramesPerTask - 1) / numFramesPerTask);
+		workerBankIndices.resize(pool->getNumThreads());
 
-		for (int i = 0; i < numX; i++) {
-			for (int j = 0; j < bandwidthPerBank; j++) {
-				bankIntensities[i][j] = spectrogramData[i][j + b * bandwidthPerBank];
+		pool->run(numTasks, [&](int task, int worker) {
+			int taskEnd = std::min(((task + 1) * numFramesPerTask), numFrames);
+			for (int i = (task * numFramesPerTask); i < taskEnd; i++) {
+				getRobustFramePoints(spectrogramData[i], numFrequencyUnits, &points[(size_t)i * numRobustPointsPerFrame], workerBankIndices[worker]);
 			}
-		}
+		});
+		return;
+	}
 
-		// get the most robust point in each filter bank
-		RobustIntensityProcessor processor(bankIntensities, 1);
-		processor.execute();
-		const vector<vector<float>> &processedIntensities = processor.intensities;
+	for (int i = 0; i < numFrames; i++) {
+		getRobustFramePoints(spectrogramData[i], numFrequencyUnits, &points[(size_t)i * numRobustPointsPerFrame]);
+	}
+}
 
-		for (int i = 0; i < numX; i++) {
-			for (int j = 0; j < bandwidthPerBank; j++) {
-				allBanksIntensities[i][j + b * bandwidthPerBank] = processedIntensities[i][j];
-			}
-		}
+// MARK: -
+// MARK: Private
+
+bool FingerprintManager::getRobustFramePoints(const float *frame, int numFrequencyUnits, int *points, vector<int> &bankIndices) const
+{
+	int bandwidthPerBank = (numFrequencyUnits / numFilterBanks);
+	if ((int)bankIndices.size() < bandwidthPerBank) {
+		bankIndices.resize(bandwidthPerBank);
 	}
 
-	vector<ArrayCoord> robustPointList;
+	int numPoints = 0;
 
-	// find robust points
-	for (int i = 0; i < (int)allBanksIntensities.size(); i++) {
-		for (int j = 0; j < (int)allBanksIntensities[i].size(); j++) {
-			if (allBanksIntensities[i][j] > 0.0f) {
-				robustPointList.push_back(ArrayCoord(i, j));
+	for (int b = 0; b < numFilterBanks; b++) {
+		// get the most robust point in the filter bank (there can be more with equal values)
+		const float *bank = frame + (b * bandwidthPerBank);
+		int numIndices = processor.getRobustIndices(bank, bandwidthPerBank, bankIndices.data());
+
+		for (int n = 0; n < numIndices; n++) {
+			int j = bankIndices[n];
+			if (bank[j] > 0.0f) {
+				if (numPoints < numRobustPointsPerFrame) {
+					points[numPoints] = ((b * bandwidthPerBank) + j);
+				}
+				numPoints += 1;
 			}
 		}
 	}
 
-	// robustLists[x] = y1, y2, y3, ...
-	vector<vector<int>> robustLists(spectrogramData.size());
-
-	for (auto coord : robustPointList) {
-		robustLists[coord.x].push_back(coord.y);
+	// only frames with exactly numRobustPointsPerFrame points are used
+	if (numPoints != numRobustPointsPerFrame) {
+		std::fill(points, (points + numRobustPointsPerFrame), -1);
+		return false;
 	}
 
-	// return the list per frame
-	return robustLists;
+	return true;
 }
@@ -9,29 +9,57 @@
 #ifndef FINGERPRINTMANAGER_H
 #define FINGERPRINTMANAGER_H
 
+#include <memory>
 #include <vector>
 #include "FingerprintProperties.h"
+#include "MatrixFloat.h"
+#include "RobustIntensityProcessor.h"
+#include "Spectrogram.h"
+#include "SpectrogramNormalizer.h"
 
+using std::unique_ptr;
 using std::vector;
 
+class ThreadPool;
+
 class FingerprintManager {
 
 public:
 
-	static int getNumFrames(const vector<uint8_t> &fingerprint);
+	// append a point in the fingerprint data format (x, y, intensity)
+	static void appendPoint(vector<uint8_t> &fingerprint, int x, int y, float intensity);
 
-	vector<uint8_t> *extractFingerprint(const int16_t *wave, int waveLength);
+	// split the frames of long waves across a thread pool (not owned, nullptr to extract on the calling thread),
+	// the fingerprints are the same as serial extraction (the pool must not be running the extraction itself)
+	void setThreadPool(ThreadPool *pool);
 
-private:
+	// (a manager reuses its spectrogram buffers between extractions, use one manager per thread)
+	vector<uint8_t> *extractFingerprint(const int16_t *wave, int waveLength, SpectrogramNormalizationType normalization = SpectrogramNormalizationType::global);
 
-	// robustLists[x] = y1, y2, y3, ...
-	vector<vector<int>> getRobustPointList(const vector<vector<float>> &spectrogramData);
+	// points[x * numRobustPointsPerFrame + n] = y, or -1 for the frames without exactly numRobustPointsPerFrame points
+	void getRobustPoints(const MatrixFloat &spectrogramData, vector<int> &points);
+
+	// the numRobustPointsPerFrame points of a frame (ascending y), returns false (and -1 points) if the frame has a different number
+	bool getRobustFramePoints(const float *frame, int numFrequencyUnits, int *points);
 
 private:
 
 	int numFilterBanks { FingerprintProperties::numFilterBanks };
+	int numRobustPointsPerFrame { FingerprintProperties::numRobustPointsPerFrame };
 	float sampleRate { FingerprintProperties::sampleRate } ;
 
+	RobustIntensityProcessor processor { 1 };	// the most robust point in each filter bank
+	vector<int> bankIndices;
+	unique_ptr<Spectrogram> spectrogram;
+
+	ThreadPool *pool { nullptr };
+	vector<vector<int>> workerBankIndices;	// the bank indices of each worker of the thread pool
+
+	static const int numFramesPerTask = 1024;	// frames per pool task
+
+
+	bool getRobustFramePoints(const float *frame, int numFrequencyUnits, int *points, vector<int> &bankIndices) const;
+
 };
 
 #endif /* FINGERPRINTMANAGER_H */
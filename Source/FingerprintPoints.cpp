@@ -0,0 +1,68 @@
+//
+//  FingerprintPoints.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "FingerprintFormat.h"
+#include "FingerprintPoints.h"
+#include "FingerprintProperties.h"
+
+
+bool FingerprintPoints::decode(const uint8_t *data, int dataSize)
+{
+	x.clear();
+	y.clear();
+	intensity.clear();
+
+	// compact fingerprints are expanded to the version 1 format first
+	vector<uint8_t> expanded;
+	if (FingerprintFormat::isCompact(data, dataSize)) {
+		if (!FingerprintFormat::decodeCompact(data, dataSize, expanded)) {
+			return false;
+		}
+		data = expanded.data();
+		dataSize = (int)expanded.size();
+	}
+
+	// each point data is 8 bytes
+	// x: 2 byte integer
+	// y: 2 byte integer
+	// intensity: 4 bytes
+	int numPoints = (dataSize / 8);
+	x.resize(numPoints);
+	y.resize(numPoints);
+	intensity.resize(numPoints);
+
+	// the frames are stored in 2 bytes and wrap after 65535, a frame below the one before
+	// is the next wrap (points are in frame order, as they are extracted)
+	int numBins = (FingerprintProperties::sampleSizePerFrame / 2);
+	int previousFrame = 0;
+	int frameBase = 0;
+
+	for (int i = 0; i < numPoints; i++) {
+		const uint8_t *point = data + (i * 8);
+		int frame = (((int)point[0] << 8) | (int)point[1]);
+		if (frame < previousFrame) {
+			frameBase += 0x10000;
+		}
+		previousFrame = frame;
+
+		x[i] = (frameBase + frame);
+		y[i] = (((int)point[2] << 8) | (int)point[3]);
+		intensity[i] = (int)(((uint32_t)point[4] << 24) | ((uint32_t)point[5] << 16) | ((uint32_t)point[6] << 8) | (uint32_t)point[7]);
+
+		// pairing and matching index arrays by frame and bin, so other data is rejected
+		if ((x[i] >= maxNumFrames) || (y[i] >= numBins)) {
+			x.clear();
+			y.clear();
+			intensity.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
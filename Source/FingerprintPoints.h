@@ -0,0 +1,57 @@
+//
+//  FingerprintPoints.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FINGERPRINTPOINTS_H
+#define FINGERPRINTPOINTS_H
+
+#include <stdint.h>
+#include <vector>
+
+using std::vector;
+
+// The points of a fingerprint, decoded once (structure of arrays).
+class FingerprintPoints {
+
+public:
+
+	vector<int> x;			// frame
+	vector<int> y;			// frequency bin
+	vector<int> intensity;
+
+	// frames per fingerprint (over 9 days at 20 frames per second)
+	static const int maxNumFrames = (1 << 24);
+
+	// decode fingerprint data (either format), returns false (and no points) if the data is not valid
+	// (the bins must be below sampleSizePerFrame / 2, frames that wrap past 65535 are unwrapped)
+	bool decode(const uint8_t *data, int dataSize);
+
+	inline int getNumPoints() const
+	{
+		return (int)x.size();
+	}
+
+};
+
+// The first numPoints points of a fingerprint.
+struct FingerprintView {
+
+	const FingerprintPoints *points;
+	int numPoints;
+
+	FingerprintView(const FingerprintPoints &points) : points(&points), numPoints(points.getNumPoints()) { }
+	FingerprintView(const FingerprintPoints &points, int numPoints) : points(&points), numPoints(numPoints) { }
+
+	// the number of frames up to the last point
+	inline int getNumFrames() const
+	{
+		return ((numPoints > 0) ? (points->x[numPoints - 1] + 1) : 0);
+	}
+
+};
+
+#endif /* FINGERPRINTPOINTS_H */
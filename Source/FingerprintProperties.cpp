@@ -49,3 +49,18 @@ int FingerprintProperties::maxTargetZoneDistance = 4;
 
 // num frequency units
 int FingerprintProperties::numFrequencyUnits = (upperBoundedFrequency - lowerBoundedFrequency + 1) / fps + 1;
+
+// windowed normalization range, in frames (20 frames per second)
+int FingerprintProperties::normalizationWindowFrames = 200;
+
+// fixed reference normalization range, in fft magnitudes (a full scale frame is close to 2^25)
+float FingerprintProperties::normalizationMinAmplitude = 1.0f;
+float FingerprintProperties::normalizationMaxAmplitude = 33554432.0f;
+
+// normalize the spectrogram with a polynomial log (simd, within 2e-7 of log2), instead of the exact log10f
+// (the intensities are no longer bit-identical to fingerprints extracted without it)
+bool FingerprintProperties::fastLogarithm = false;
+
+// order points with equal intensities by their position when pairing (a radix sort), instead of the quick sort order
+// (the pairs differ from pairing without it when intensities repeat)
+bool FingerprintProperties::stableIntensityOrder = false;
@@ -27,6 +27,11 @@ public:
 	static int anchorPointsIntervalLength;
 	static int maxTargetZoneDistance;
 	static int numFrequencyUnits;
+	static int normalizationWindowFrames;
+	static float normalizationMinAmplitude;
+	static float normalizationMaxAmplitude;
+	static bool fastLogarithm;
+	static bool stableIntensityOrder;
 
 };
 
@@ -8,22 +8,52 @@
 
 
 #include <limits.h>
+#include <algorithm>
 #include "Fingerprint.h"
-#include "FingerprintManager.h"
+#include "FingerprintProperties.h"
 #include "FingerprintSimilarityComputer.h"
-#include "MapRankInteger.h"
-#include "PairManager.h"
 
 
-FingerprintSimilarityComputer::FingerprintSimilarityComputer(const vector<uint8_t> &fingerprint1, const vector<uint8_t> &fingerprint2) : fingerprint1(fingerprint1), fingerprint2(fingerprint2)
+FingerprintSimilarityComputer::FingerprintSimilarityComputer(const FingerprintView &fingerprint1, const FingerprintView &fingerprint2) : fingerprint1(fingerprint1), fingerprint2(fingerprint2)
 {
 }
 
 FingerprintSimilarity FingerprintSimilarityComputer::getMatchResults()
+{
+	// get the pairs
+	PairPositionTable table1(fingerprint1);
+	PairPositionTable table2(fingerprint2);
+
+	return getMatchResults(table1, table2);
+}
+
+FingerprintSimilarity FingerprintSimilarityComputer::getMatchResults(const PairPositionTable &table1, const PairPositionTable &table2)
+{
+	return getSimilarity(getOffsetHistogram(table1, table2), getNumFrames(table1, table2));
+}
+
+vector<FingerprintAlignment> FingerprintSimilarityComputer::getAlignments(const PairPositionTable &table1, const PairPositionTable &table2, int maxAlignments)
+{
+	OffsetHistogram offsetHistogram = getOffsetHistogram(table1, table2);
+	int numFrames = getNumFrames(table1, table2);
+
+	vector<FingerprintAlignment> alignments;
+	for (auto& offsetCount : offsetHistogram.getBestOffsets(maxAlignments)) {
+		FingerprintAlignment alignment;
+		alignment.framePosition = offsetCount.offset;
+		alignment.startTime = getStartTime(offsetCount.offset);
+		alignment.numMatches = offsetCount.count;
+		alignment.score = getScore(offsetHistogram, offsetCount.offset, offsetCount.count, numFrames);
+		alignment.similarity = std::min(alignment.score, 1.0f);
+		alignments.push_back(alignment);
+	}
+
+	return alignments;
+}
+
+FingerprintSimilarity FingerprintSimilarityComputer::getSimilarity(const OffsetHistogram &offsetHistogram, int numFrames)
 {
 	FingerprintSimilarity results;
-	map<int, int> offsetScoreTable;
-	int numFrames = 0;
 
 	// reset the results
 	results.score = 0.0f;
@@ -31,80 +61,97 @@ FingerprintSimilarity FingerprintSimilarityComputer::getMatchResults()
 	results.mostSimilarFramePosition = INT_MIN;
 	results.mostSimilarStartTime = 1.0f;
 
-	// one frame may contain several points, use the shorter one be the denominator
-	if (fingerprint1.size() > fingerprint2.size()) {
-		numFrames = FingerprintManager::getNumFrames(fingerprint2);
+	// get the highest score position
+	int offset = 0;
+	int offsetScore = 0;
+	if (offsetHistogram.getBestOffset(offset, offsetScore)) {
+		results.mostSimilarFramePosition = offset;
+		results.score = getScore(offsetHistogram, offset, offsetScore, numFrames);
 	} else {
-		numFrames = FingerprintManager::getNumFrames(fingerprint1);
+		results.score /= (float)numFrames;
 	}
 
-	// get the pairs
-	PairManager pairManager;
-	map<int, vector<int>> this_Pair_PositionList_Table = pairManager.getPair_PositionList_Table(fingerprint1);
-	map<int, vector<int>> compareWave_Pair_PositionList_Table = pairManager.getPair_PositionList_Table(fingerprint2);
-
-	for (auto& it : compareWave_Pair_PositionList_Table) {
-		int compareWaveHashNumber = it.first;
+	results.similarity = results.score;
+	if (results.similarity > 1.0f) {
+		// similarity > 1.0 means in average there is at least one match in every frame
+		results.similarity = 1.0f;
+	}
 
-		// for each compare hash number, get the positions
-		// if the compareWaveHashNumber in either table, no need to compare
-		if ((this_Pair_PositionList_Table.find(compareWaveHashNumber) == this_Pair_PositionList_Table.end()) ||
-			(compareWave_Pair_PositionList_Table.find(compareWaveHashNumber) == compareWave_Pair_PositionList_Table.end())) {
-			continue;
-		}
+	// calculate the most similar start time
+	results.mostSimilarStartTime = getStartTime(results.mostSimilarFramePosition);
 
-		vector<int>& wavePositionList = this_Pair_PositionList_Table[compareWaveHashNumber];
-		vector<int>& compareWavePositionList = compareWave_Pair_PositionList_Table[compareWaveHashNumber];
+	return results;
+}
 
-		for (auto& thisPosition : wavePositionList) {
-			for (auto& compareWavePosition : compareWavePositionList) {
-				int offset = (thisPosition - compareWavePosition);
+// MARK: -
+// MARK: Private
 
-				if (offsetScoreTable.find(offset) != offsetScoreTable.end()) {
-					offsetScoreTable[offset] += 1;
-				} else {
-					offsetScoreTable[offset] = 1;
-				}
-			}
-		}
+int FingerprintSimilarityComputer::getNumFrames(const PairPositionTable &table1, const PairPositionTable &table2)
+{
+	// one frame may contain several points, use the shorter one be the denominator
+	if (table1.getNumPoints() > table2.getNumPoints()) {
+		return table2.getNumFrames();
 	}
+	return table1.getNumFrames();
+}
 
-	// map rank
-	MapRankInteger mapRank = MapRankInteger(offsetScoreTable, false);
-
-	// get the most similar positions and scores
-	vector<int> orderedKeyList = mapRank.getOrderedKeyList(100, true);
-	if (orderedKeyList.size() > 0) {
-		int key = orderedKeyList[0];
+OffsetHistogram FingerprintSimilarityComputer::getOffsetHistogram(const PairPositionTable &table1, const PairPositionTable &table2)
+{
+	// positions are frames, so the offsets are within the frame counts
+	// (FingerprintPoints::decode unwraps the frames so they never decrease, so no position is past the last frame)
+	OffsetHistogram offsetHistogram((1 - table2.getNumFrames()), (table1.getNumFrames() - 1));
+
+	// merge join the sorted hashcodes of both tables (skipping ahead in whichever table is behind,
+	// so a short clip against a long reference only touches a few of the reference keys)
+	int numKeys1 = table1.getNumKeys();
+	int numKeys2 = table2.getNumKeys();
+	int key1 = 0;
+	int key2 = 0;
+
+	while ((key1 < numKeys1) && (key2 < numKeys2)) {
+		int hashcode1 = table1.getKey(key1);
+		int hashcode2 = table2.getKey(key2);
+
+		if (hashcode1 < hashcode2) {
+			key1 = table1.skipToKey(key1, hashcode2);
+			continue;
+		}
+		if (hashcode2 < hashcode1) {
+			key2 = table2.skipToKey(key2, hashcode1);
+			continue;
+		}
 
-		// get the highest score position
-		if (results.mostSimilarFramePosition == INT_MIN) {
-			results.mostSimilarFramePosition = key;
-			results.score = (float)offsetScoreTable[key];
+		// the pair is in both tables
+		int numPositions = 0;
+		int numComparePositions = 0;
+		const int *wavePositionList = table1.getPositions(key1, numPositions);
+		const int *compareWavePositionList = table2.getPositions(key2, numComparePositions);
 
-			// accumulate the scores from neighbors
-//			if int offsetScore = offsetScoreTable[(key - 1)] {
-			if (offsetScoreTable.find(key - 1) != offsetScoreTable.end()) {
-				int offsetScore = offsetScoreTable[key - 1];
-				results.score += (float)(offsetScore / 2);
-			}
-//			if int offsetScore = offsetScoreTable[(key + 1)] {
-			if (offsetScoreTable.find(key + 1) != offsetScoreTable.end()) {
-				int offsetScore = offsetScoreTable[key + 1];
-				results.score += (float)(offsetScore / 2);
+		for (int i = 0; i < numPositions; i++) {
+			for (int j = 0; j < numComparePositions; j++) {
+				offsetHistogram.add(wavePositionList[i] - compareWavePositionList[j]);
 			}
 		}
-	}
 
-	results.score /= (float)numFrames;
-	results.similarity = results.score;
-	if (results.similarity > 1.0f) {
-		// similarity > 1.0 means in average there is at least one match in every frame
-		results.similarity = 1.0f;
+		key1 += 1;
+		key2 += 1;
 	}
 
-	// calculate the most similar start time
-	results.mostSimilarStartTime = ((float)results.mostSimilarFramePosition / (float)FingerprintProperties::numRobustPointsPerFrame / (float)FingerprintProperties::fps);
+	return offsetHistogram;
+}
 
-	return results;
+float FingerprintSimilarityComputer::getScore(const OffsetHistogram &offsetHistogram, int offset, int count, int numFrames)
+{
+	float score = (float)count;
+
+	// accumulate the scores from neighbors
+	score += (float)(offsetHistogram.getCount(offset - 1) / 2);
+	score += (float)(offsetHistogram.getCount(offset + 1) / 2);
+
+	return (score / (float)numFrames);
+}
+
+float FingerprintSimilarityComputer::getStartTime(int offset)
+{
+	return ((float)offset / (float)FingerprintProperties::numRobustPointsPerFrame / (float)FingerprintProperties::fps);
 }
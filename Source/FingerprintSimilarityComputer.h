@@ -9,25 +9,41 @@
 #ifndef FINGERPRINTSIMILARITYCOMPUTER_H
 #define FINGERPRINTSIMILARITYCOMPUTER_H
 
-#include <map>
 #include <vector>
+#include "FingerprintPoints.h"
+#include "OffsetHistogram.h"
+#include "PairPositionTable.h"
 
-using std::map;
 using std::vector;
 
+struct FingerprintAlignment;
 struct FingerprintSimilarity;
 
 class FingerprintSimilarityComputer {
 
 public:
 
-	FingerprintSimilarityComputer(const vector<uint8_t> &fingerprint1, const vector<uint8_t> &fingerprint2);
+	FingerprintSimilarityComputer(const FingerprintView &fingerprint1, const FingerprintView &fingerprint2);
 	FingerprintSimilarity getMatchResults();
 
+	// compare two precomputed pair tables
+	static FingerprintSimilarity getMatchResults(const PairPositionTable &table1, const PairPositionTable &table2);
+
+	// the best alignments of two precomputed pair tables, ordered by matches
+	static vector<FingerprintAlignment> getAlignments(const PairPositionTable &table1, const PairPositionTable &table2, int maxAlignments);
+
+	// the similarity for the offset histogram (offset = position1 - position2)
+	static FingerprintSimilarity getSimilarity(const OffsetHistogram &offsetHistogram, int numFrames);
+
 private:
 
-	vector<uint8_t> fingerprint1;
-	vector<uint8_t> fingerprint2;
+	static int getNumFrames(const PairPositionTable &table1, const PairPositionTable &table2);
+	static OffsetHistogram getOffsetHistogram(const PairPositionTable &table1, const PairPositionTable &table2);
+	static float getScore(const OffsetHistogram &offsetHistogram, int offset, int count, int numFrames);
+	static float getStartTime(int offset);
+
+	FingerprintView fingerprint1;
+	FingerprintView fingerprint2;
 
 };
 
@@ -0,0 +1,146 @@
+//
+//  FingerprintStreamExtractor.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include <string.h>
+#include "FingerprintProperties.h"
+#include "FingerprintStreamExtractor.h"
+#include "Spectrogram.h"
+#include "WindowFunction.h"
+
+
+FingerprintStreamExtractor::FingerprintStreamExtractor(SpectrogramNormalizationType normalization) :
+	fft(FingerprintProperties::sampleSizePerFrame),
+	fftSampleSize(FingerprintProperties::sampleSizePerFrame),
+	overlapFactor(FingerprintProperties::overlapFactor),
+	numRobustPointsPerFrame(FingerprintProperties::numRobustPointsPerFrame),
+	normalizer(((normalization == SpectrogramNormalizationType::global) ? SpectrogramNormalizationType::running : normalization), fft.getNumMagnitudes())
+{
+	window = WindowFunction::generate(WindowFunctionType::hamming, fftSampleSize);
+	hopSize = Spectrogram::getHopSize(fftSampleSize, overlapFactor);
+
+	// a frame spans fftSampleSize - 1 samples, or a full hop without overlap
+	frameBuffer.resize(std::max((fftSampleSize - 1), hopSize));
+
+	signal.resize(1, fftSampleSize);
+	absoluteFrame.resize(1, fft.getNumMagnitudes());
+	frame.resize(1, fft.getNumMagnitudes());
+	framePoints.resize(numRobustPointsPerFrame);
+}
+
+int FingerprintStreamExtractor::push(const int16_t *wave, int waveLength)
+{
+	// safety check
+	if (flushed || (wave == NULL) || (waveLength <= 0)) {
+		return 0;
+	}
+
+	int numCompletedFrames = 0;
+	int capacity = (int)frameBuffer.size();
+
+	while (waveLength > 0) {
+		// fill the frame buffer
+		int count = std::min((capacity - numBufferedSamples), waveLength);
+		memcpy((frameBuffer.data() + numBufferedSamples), wave, (count * sizeof(int16_t)));
+		numBufferedSamples += count;
+		numSamples += count;
+		wave += count;
+		waveLength -= count;
+
+		while (isFrameReady()) {
+			processFrame();
+			numCompletedFrames += 1;
+
+			// move to the start of the next frame
+			numBufferedSamples -= hopSize;
+			memmove(frameBuffer.data(), (frameBuffer.data() + hopSize), (numBufferedSamples * sizeof(int16_t)));
+		}
+	}
+
+	return numCompletedFrames;
+}
+
+int FingerprintStreamExtractor::flush()
+{
+	if (flushed) {
+		return 0;
+	}
+
+	flushed = true;
+
+	// the frame where the stream ends is zero padded, the frames after it have no samples (and no points)
+	int64_t numStreamFrames = ((numSamples * std::max(overlapFactor, 1)) / fftSampleSize);
+	if (numFrames >= numStreamFrames) {
+		return 0;
+	}
+
+	processFrame();
+	numBufferedSamples = 0;
+
+	return 1;
+}
+
+void FingerprintStreamExtractor::pull(vector<uint8_t> &fingerprintData)
+{
+	if (!segments.empty()) {
+		// the oldest full segment
+		Segment &segment = segments.front();
+		fingerprintData.insert(fingerprintData.end(), segment.points.begin(), segment.points.end());
+		pullStartFrame = segment.startFrame;
+		segments.erase(segments.begin());
+		return;
+	}
+
+	// the current segment, the next one starts at the next frame
+	fingerprintData.insert(fingerprintData.end(), points.begin(), points.end());
+	points.clear();
+	pullStartFrame = segmentStartFrame;
+	segmentStartFrame = numFrames;
+}
+
+// MARK: -
+// MARK: Private
+
+bool FingerprintStreamExtractor::isFrameReady() const
+{
+	// the frame needs all of its samples and has to be part of the spectrogram of the samples so far
+	int64_t numStreamFrames = ((numSamples * std::max(overlapFactor, 1)) / fftSampleSize);
+	return ((numBufferedSamples == (int)frameBuffer.size()) && (numFrames < numStreamFrames));
+}
+
+void FingerprintStreamExtractor::processFrame()
+{
+	// window and transform the frame
+	Spectrogram::windowSamples(frameBuffer.data(), numBufferedSamples, fftSampleSize, hopSize, window.data(), signal[0]);
+	fft.getMagnitudes(signal[0], 0, 1, absoluteFrame[0], 0);
+
+	// normalize against the amplitude range so far
+	normalizer.addFrame(absoluteFrame[0]);
+	normalizer.normalizeFrame(absoluteFrame[0], frame[0]);
+
+	// start a new segment when x does not fit in the current one
+	if ((numFrames - segmentStartFrame) >= maxSegmentFrames) {
+		if (!points.empty()) {
+			segments.push_back({ segmentStartFrame, vector<uint8_t>() });
+			segments.back().points.swap(points);
+		}
+		segmentStartFrame = numFrames;
+	}
+
+	// select the robust points
+	if (fingerprinter.getRobustFramePoints(frame[0], frame.getNumColumns(), framePoints.data())) {
+		int x = (int)(numFrames - segmentStartFrame);
+		for (int n = 0; n < numRobustPointsPerFrame; n++) {
+			int y = framePoints[n];
+			FingerprintManager::appendPoint(points, x, y, frame[0][y]);
+		}
+	}
+
+	numFrames += 1;
+}
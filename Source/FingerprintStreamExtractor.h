@@ -0,0 +1,103 @@
+//
+//  FingerprintStreamExtractor.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FINGERPRINTSTREAMEXTRACTOR_H
+#define FINGERPRINTSTREAMEXTRACTOR_H
+
+#include <stdint.h>
+#include <vector>
+#include "FastFourierTransform.h"
+#include "FingerprintManager.h"
+#include "MatrixFloat.h"
+#include "SpectrogramNormalizer.h"
+
+using std::vector;
+
+// Extracts fingerprint points from audio that arrives in pieces.
+// Only the samples of the next frame are buffered, each frame is transformed and
+// its robust points are selected as soon as all of its samples have arrived.
+// The points are normalized as soon as their frame is complete, so the global
+// amplitude range is not available (it is replaced with the running range).
+// The points are pulled in segments of at most maxSegmentFrames frames, the x-coordinate
+// of a point is its frame from the start of its segment (it has 2 bytes).
+class FingerprintStreamExtractor {
+
+public:
+
+	FingerprintStreamExtractor(SpectrogramNormalizationType normalization = SpectrogramNormalizationType::running);
+
+	// add samples to the stream, returns the number of frames completed
+	int push(const int16_t *wave, int waveLength);
+
+	// complete the frame at the end of the stream, no samples can be pushed afterwards
+	int flush();
+
+	// move the points of the oldest segment not pulled yet into the fingerprint data
+	// (the frames completed since the last pull, split at maxSegmentFrames, pull until there are no points)
+	void pull(vector<uint8_t> &fingerprintData);
+
+	// the stream frame of x = 0 in the last pulled segment
+	inline int64_t getPullStartFrame() const
+	{
+		return pullStartFrame;
+	}
+
+	inline int64_t getNumFrames() const
+	{
+		return numFrames;
+	}
+
+	inline bool isFlushed() const
+	{
+		return flushed;
+	}
+
+private:
+
+	FingerprintManager fingerprinter;
+	FastFourierTransform fft;
+	vector<float> window;
+
+	int fftSampleSize;
+	int overlapFactor;
+	int hopSize;
+	int numRobustPointsPerFrame;
+
+	vector<int16_t> frameBuffer;	// samples from the start of the next frame
+	int numBufferedSamples { 0 };
+	int64_t numSamples { 0 };		// total samples pushed
+	int64_t numFrames { 0 };		// frames completed
+
+	MatrixFloat signal;
+	MatrixFloat absoluteFrame;
+	MatrixFloat frame;				// normalized frame
+	SpectrogramNormalizer normalizer;
+	vector<int> framePoints;
+
+	struct Segment {
+
+		int64_t startFrame;
+		vector<uint8_t> points;
+
+	};
+
+	static const int maxSegmentFrames = 0x10000;	// frames of a segment (x fits in 2 bytes)
+
+	vector<Segment> segments;		// full segments not pulled yet
+	vector<uint8_t> points;			// points of the current segment
+	int64_t segmentStartFrame { 0 };
+	int64_t pullStartFrame { 0 };
+	bool flushed { false };
+
+
+	bool isFrameReady() const;
+	void processFrame();
+
+};
+
+#endif /* FINGERPRINTSTREAMEXTRACTOR_H */
@@ -0,0 +1,139 @@
+//
+//  FloatLanes.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FLOATLANES_H
+#define FLOATLANES_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// A fixed number of floats that are processed in lock-step (one lane per fft frame).
+// The operations are plain per-lane loops, so FloatLanes<1> behaves exactly like a float.
+template <int N>
+struct FloatLanes {
+
+	static const int numLanes = N;
+
+	float v[N];
+
+	static inline FloatLanes load(const float *pointer)
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = pointer[l];
+		}
+		return result;
+	}
+
+	static inline FloatLanes broadcast(float value)
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = value;
+		}
+		return result;
+	}
+
+	inline void store(float *pointer) const
+	{
+		for (int l = 0; l < N; l++) {
+			pointer[l] = v[l];
+		}
+	}
+
+	inline FloatLanes operator+(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = v[l] + other.v[l];
+		}
+		return result;
+	}
+
+	inline FloatLanes operator-(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = v[l] - other.v[l];
+		}
+		return result;
+	}
+
+	inline FloatLanes operator*(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = v[l] * other.v[l];
+		}
+		return result;
+	}
+
+	inline FloatLanes operator/(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = v[l] / other.v[l];
+		}
+		return result;
+	}
+
+	inline FloatLanes sqrt() const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = sqrtf(v[l]);
+		}
+		return result;
+	}
+
+	inline FloatLanes min(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = (other.v[l] < v[l]) ? other.v[l] : v[l];
+		}
+		return result;
+	}
+
+	inline FloatLanes max(const FloatLanes &other) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = (other.v[l] > v[l]) ? other.v[l] : v[l];
+		}
+		return result;
+	}
+
+	// value in the lanes that are >= threshold, zero in the others
+	inline FloatLanes selectGreaterEqual(const FloatLanes &threshold, const FloatLanes &value) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			result.v[l] = (v[l] >= threshold.v[l]) ? value.v[l] : 0.0f;
+		}
+		return result;
+	}
+
+	// split positive normal values into mantissa (1.0 - 2.0) and exponent
+	inline FloatLanes splitExponent(FloatLanes &exponent) const
+	{
+		FloatLanes result;
+		for (int l = 0; l < N; l++) {
+			uint32_t bits;
+			memcpy(&bits, &v[l], sizeof(bits));
+			exponent.v[l] = (float)((int)(bits >> 23) - 127);
+			bits = ((bits & 0x007FFFFF) | 0x3F800000);
+			memcpy(&result.v[l], &bits, sizeof(bits));
+		}
+		return result;
+	}
+
+};
+
+#endif /* FLOATLANES_H */
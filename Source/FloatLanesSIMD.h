@@ -0,0 +1,107 @@
+//
+//  FloatLanesSIMD.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef FLOATLANESSIMD_H
+#define FLOATLANESSIMD_H
+
+// FloatLanes (see FloatLanes.h) for the simd instruction sets that are part of the
+// baseline of the target (sse2 on x86, neon on arm64).
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+
+// MARK: SSE
+
+#if defined(__SSE2__)
+
+struct FloatLanesSSE {
+
+	static const int numLanes = 4;
+
+	__m128 v;
+
+	static inline FloatLanesSSE load(const float *pointer) { return { _mm_loadu_ps(pointer) }; }
+	static inline FloatLanesSSE broadcast(float value) { return { _mm_set1_ps(value) }; }
+	inline void store(float *pointer) const { _mm_storeu_ps(pointer, v); }
+
+	inline FloatLanesSSE operator+(const FloatLanesSSE &other) const { return { _mm_add_ps(v, other.v) }; }
+	inline FloatLanesSSE operator-(const FloatLanesSSE &other) const { return { _mm_sub_ps(v, other.v) }; }
+	inline FloatLanesSSE operator*(const FloatLanesSSE &other) const { return { _mm_mul_ps(v, other.v) }; }
+	inline FloatLanesSSE operator/(const FloatLanesSSE &other) const { return { _mm_div_ps(v, other.v) }; }
+	inline FloatLanesSSE sqrt() const { return { _mm_sqrt_ps(v) }; }
+
+	inline FloatLanesSSE min(const FloatLanesSSE &other) const { return { _mm_min_ps(v, other.v) }; }
+	inline FloatLanesSSE max(const FloatLanesSSE &other) const { return { _mm_max_ps(v, other.v) }; }
+
+	// value in the lanes that are >= threshold, zero in the others
+	inline FloatLanesSSE selectGreaterEqual(const FloatLanesSSE &threshold, const FloatLanesSSE &value) const
+	{
+		return { _mm_and_ps(_mm_cmpge_ps(v, threshold.v), value.v) };
+	}
+
+	// split positive normal values into mantissa (1.0 - 2.0) and exponent
+	inline FloatLanesSSE splitExponent(FloatLanesSSE &exponent) const
+	{
+		__m128i bits = _mm_castps_si128(v);
+		exponent.v = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+		return { _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000))) };
+	}
+
+};
+
+#endif // __SSE2__
+
+// MARK: -
+// MARK: NEON
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+struct FloatLanesNEON {
+
+	static const int numLanes = 4;
+
+	float32x4_t v;
+
+	static inline FloatLanesNEON load(const float *pointer) { return { vld1q_f32(pointer) }; }
+	static inline FloatLanesNEON broadcast(float value) { return { vdupq_n_f32(value) }; }
+	inline void store(float *pointer) const { vst1q_f32(pointer, v); }
+
+	inline FloatLanesNEON operator+(const FloatLanesNEON &other) const { return { vaddq_f32(v, other.v) }; }
+	inline FloatLanesNEON operator-(const FloatLanesNEON &other) const { return { vsubq_f32(v, other.v) }; }
+	inline FloatLanesNEON operator*(const FloatLanesNEON &other) const { return { vmulq_f32(v, other.v) }; }
+	inline FloatLanesNEON operator/(const FloatLanesNEON &other) const { return { vdivq_f32(v, other.v) }; }
+	inline FloatLanesNEON sqrt() const { return { vsqrtq_f32(v) }; }
+
+	inline FloatLanesNEON min(const FloatLanesNEON &other) const { return { vminq_f32(v, other.v) }; }
+	inline FloatLanesNEON max(const FloatLanesNEON &other) const { return { vmaxq_f32(v, other.v) }; }
+
+	// value in the lanes that are >= threshold, zero in the others
+	inline FloatLanesNEON selectGreaterEqual(const FloatLanesNEON &threshold, const FloatLanesNEON &value) const
+	{
+		return { vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(v, threshold.v), vreinterpretq_u32_f32(value.v))) };
+	}
+
+	// split positive normal values into mantissa (1.0 - 2.0) and exponent
+	inline FloatLanesNEON splitExponent(FloatLanesNEON &exponent) const
+	{
+		uint32x4_t bits = vreinterpretq_u32_f32(v);
+		exponent.v = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127)));
+		return { vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F800000))) };
+	}
+
+};
+
+#endif // __ARM_NEON && __aarch64__
+
+#endif /* FLOATLANESSIMD_H */
@@ -0,0 +1,152 @@
+//
+//  MappedPairHashIndex.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include "MappedPairHashIndex.h"
+
+
+const uint8_t MappedPairHashIndex::magic[3] = { 'F', 'P', 'I' };
+
+MappedPairHashIndex *MappedPairHashIndex::open(const char *filePath)
+{
+	// open the file
+	int file = ::open(filePath, O_RDONLY);
+	if (file < 0) {
+		return nullptr;
+	}
+
+	struct stat fileInfo;
+	if ((fstat(file, &fileInfo) != 0) || (fileInfo.st_size < (off_t)sizeof(Header))) {
+		close(file);
+		return nullptr;
+	}
+
+	// map the file (the mapping stays valid after closing the file)
+	size_t fileSize = (size_t)fileInfo.st_size;
+	void *mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (mapping == MAP_FAILED) {
+		return nullptr;
+	}
+
+	MappedPairHashIndex *index = new MappedPairHashIndex();
+	index->mapping = mapping;
+	index->mappingSize = fileSize;
+
+	// check the header
+	const Header *header = (const Header*)mapping;
+	if ((memcmp(header->magic, magic, sizeof(magic)) != 0) || (header->version != version)) {
+		delete index;
+		return nullptr;
+	}
+
+	// check the size of the sections
+	uint64_t offsetsSize = ((uint64_t)(header->numKeys + 1ULL) * sizeof(uint64_t));
+	uint64_t keysSize = ((uint64_t)header->numKeys * sizeof(int32_t));
+	uint64_t referencesSize = ((uint64_t)header->numReferences * sizeof(PairHashReference));
+	uint64_t postingsSize = (header->numPostings * sizeof(PairHashPosting));
+	if ((header->numPostings > (fileSize / sizeof(PairHashPosting))) ||
+		((sizeof(Header) + offsetsSize + keysSize + referencesSize + postingsSize) != fileSize)) {
+		delete index;
+		return nullptr;
+	}
+
+	const uint8_t *data = ((const uint8_t*)mapping + sizeof(Header));
+	index->numReferences = header->numReferences;
+	index->numKeys = header->numKeys;
+	index->offsets = (const uint64_t*)data;
+	index->keys = (const int32_t*)(data + offsetsSize);
+	index->references = (const PairHashReference*)(data + offsetsSize + keysSize);
+	index->postings = (const PairHashPosting*)(data + offsetsSize + keysSize + referencesSize);
+
+	if ((index->offsets[index->numKeys] != header->numPostings) || !index->isValid()) {
+		delete index;
+		return nullptr;
+	}
+
+	return index;
+}
+
+MappedPairHashIndex::~MappedPairHashIndex()
+{
+	if (mapping != nullptr) {
+		munmap(mapping, mappingSize);
+	}
+}
+
+// MARK: -
+// MARK: Protected
+
+const PairHashPosting *MappedPairHashIndex::getPostings(int hashcode, int &numPostings) const
+{
+	numPostings = 0;
+
+	// binary search the sorted keys
+	const int32_t *keysEnd = (keys + numKeys);
+	const int32_t *key = std::lower_bound(keys, keysEnd, (int32_t)hashcode);
+	if ((key == keysEnd) || (*key != hashcode)) {
+		return nullptr;
+	}
+
+	size_t keyIndex = (size_t)(key - keys);
+	uint64_t begin = offsets[keyIndex];
+	uint64_t end = offsets[keyIndex + 1];
+
+	numPostings = (int)(end - begin);
+	return (postings + begin);
+}
+
+// MARK: -
+// MARK: Private
+
+bool MappedPairHashIndex::isValid() const
+{
+	// the contents are read without checks, so a damaged file is rejected here
+	// (one pass over the file when it is opened)
+	uint64_t numPostings = offsets[numKeys];
+	if (offsets[0] != 0) {
+		return false;
+	}
+
+	for (uint32_t key = 0; key < numKeys; key++) {
+		if (offsets[key] > offsets[key + 1]) {
+			return false;
+		}
+		if ((offsets[key + 1] - offsets[key]) > (uint64_t)INT32_MAX) {
+			return false;
+		}
+		if ((key > 0) && (keys[key - 1] >= keys[key])) {
+			return false;
+		}
+	}
+
+	for (uint32_t slot = 0; slot < numReferences; slot++) {
+		if ((references[slot].numPoints < 0) || (references[slot].numFrames < 0)) {
+			return false;
+		}
+	}
+
+	// the positions are frames of the reference
+	for (uint64_t i = 0; i < numPostings; i++) {
+		const PairHashPosting &posting = postings[i];
+		if ((posting.reference < 0) || ((uint32_t)posting.reference >= numReferences)) {
+			return false;
+		}
+		if ((posting.position < 0) || (posting.position >= references[posting.reference].numFrames)) {
+			return false;
+		}
+	}
+
+	return true;
+}
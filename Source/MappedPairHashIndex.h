@@ -0,0 +1,81 @@
+//
+//  MappedPairHashIndex.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef MAPPEDPAIRHASHINDEX_H
+#define MAPPEDPAIRHASHINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "PairHashIndexReader.h"
+
+// A read-only pair hash index that serves lookups from a memory mapped index file,
+// so the index is not loaded into memory and the pages are shared between processes.
+//
+// Index file layout (version 1, native byte order):
+//	Header
+//	uint64_t offsets[numKeys + 1]		first posting of each key
+//	int32_t keys[numKeys]				sorted pair hashcodes
+//	PairHashReference references[numReferences]
+//	PairHashPosting postings[numPostings]
+class MappedPairHashIndex : public PairHashIndexReader {
+
+public:
+
+	struct Header {
+
+		uint8_t magic[3];	// 'F', 'P', 'I'
+		uint8_t version;
+		uint32_t numReferences;
+		uint32_t numKeys;
+		uint32_t reserved;
+		uint64_t numPostings;
+
+	};
+
+	static const uint8_t magic[3];
+	static const uint8_t version = 1;
+
+	// map an index file, returns nullptr if the file is not a valid index (its contents are checked once)
+	static MappedPairHashIndex *open(const char *filePath);
+
+	~MappedPairHashIndex();
+
+	inline int getNumReferences() const override
+	{
+		return (int)numReferences;
+	}
+
+protected:
+
+	const PairHashPosting *getPostings(int hashcode, int &numPostings) const override;
+
+	inline const PairHashReference &getReference(int slot) const override
+	{
+		return references[slot];
+	}
+
+private:
+
+	void *mapping { nullptr };
+	size_t mappingSize { 0 };
+
+	uint32_t numReferences { 0 };
+	uint32_t numKeys { 0 };
+	const uint64_t *offsets { nullptr };
+	const int32_t *keys { nullptr };
+	const PairHashReference *references { nullptr };
+	const PairHashPosting *postings { nullptr };
+
+	MappedPairHashIndex() { }
+
+	// check the offsets, keys, references and postings of the mapped file
+	bool isValid() const;
+
+};
+
+#endif /* MAPPEDPAIRHASHINDEX_H */
@@ -0,0 +1,117 @@
+//
+//  MatrixFloat.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include "MatrixFloat.h"
+
+
+MatrixFloat::MatrixFloat()
+{
+}
+
+MatrixFloat::MatrixFloat(int numRows, int numColumns)
+{
+	resize(numRows, numColumns);
+}
+
+MatrixFloat::MatrixFloat(const MatrixFloat &other)
+{
+	*this = other;
+}
+
+MatrixFloat::MatrixFloat(MatrixFloat &&other)
+{
+	*this = std::move(other);
+}
+
+MatrixFloat::~MatrixFloat()
+{
+	release();
+}
+
+MatrixFloat& MatrixFloat::operator=(const MatrixFloat &other)
+{
+	if (this != &other) {
+		resize(other.numRows, other.numColumns);
+		if (storage != nullptr) {
+			memcpy(storage, other.storage, ((size_t)numRows * stride * sizeof(float)));
+		}
+	}
+
+	return *this;
+}
+
+MatrixFloat& MatrixFloat::operator=(MatrixFloat &&other)
+{
+	if (this != &other) {
+		release();
+		storage = other.storage;
+		capacity = other.capacity;
+		numRows = other.numRows;
+		numColumns = other.numColumns;
+		stride = other.stride;
+
+		other.storage = nullptr;
+		other.capacity = 0;
+		other.numRows = 0;
+		other.numColumns = 0;
+		other.stride = 0;
+	}
+
+	return *this;
+}
+
+void MatrixFloat::resize(int numRows, int numColumns)
+{
+	const int floatsPerAlignment = (alignment / (int)sizeof(float));
+
+	int stride = ((numColumns + floatsPerAlignment - 1) / floatsPerAlignment) * floatsPerAlignment;
+	size_t size = ((size_t)numRows * stride * sizeof(float));
+
+	// keep the allocation when it is large enough
+	if (size > capacity) {
+		release();
+
+		if (size > 0) {
+			void *pointer = NULL;
+			if (posix_memalign(&pointer, alignment, size) != 0) {
+				throw std::bad_alloc();
+			}
+
+			storage = (float*)pointer;
+			capacity = size;
+		}
+	}
+
+	if (size > 0) {
+		memset(storage, 0, size);
+	}
+
+	this->numRows = numRows;
+	this->numColumns = numColumns;
+	this->stride = stride;
+}
+
+// MARK: -
+// MARK: Private
+
+void MatrixFloat::release()
+{
+	if (storage != nullptr) {
+		free(storage);
+		storage = nullptr;
+	}
+
+	capacity = 0;
+	numRows = 0;
+	numColumns = 0;
+	stride = 0;
+}
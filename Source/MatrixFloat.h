@@ -0,0 +1,82 @@
+//
+//  MatrixFloat.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef MATRIXFLOAT_H
+#define MATRIXFLOAT_H
+
+#include <stddef.h>
+
+// A row-major (frames x bins) matrix in a single allocation.
+// Every row starts on a 32 byte boundary, so rows can be processed with simd loads.
+class MatrixFloat {
+
+public:
+
+	static const int alignment = 32;	// bytes
+
+	MatrixFloat();
+	MatrixFloat(int numRows, int numColumns);
+	MatrixFloat(const MatrixFloat &other);
+	MatrixFloat(MatrixFloat &&other);
+	~MatrixFloat();
+
+	MatrixFloat& operator=(const MatrixFloat &other);
+	MatrixFloat& operator=(MatrixFloat &&other);
+
+	// resize the matrix, all values are reset to zero (the allocation is kept when it is large enough)
+	void resize(int numRows, int numColumns);
+
+	inline int getNumRows() const
+	{
+		return numRows;
+	}
+
+	inline int getNumColumns() const
+	{
+		return numColumns;
+	}
+
+	// distance between the rows in floats (numColumns rounded up to the alignment)
+	inline int getStride() const
+	{
+		return stride;
+	}
+
+	inline float *getRow(int row)
+	{
+		return (storage + ((size_t)row * stride));
+	}
+
+	inline const float *getRow(int row) const
+	{
+		return (storage + ((size_t)row * stride));
+	}
+
+	inline float *operator[](int row)
+	{
+		return getRow(row);
+	}
+
+	inline const float *operator[](int row) const
+	{
+		return getRow(row);
+	}
+
+private:
+
+	float *storage { nullptr };
+	size_t capacity { 0 };	// bytes
+	int numRows { 0 };
+	int numColumns { 0 };
+	int stride { 0 };
+
+	void release();
+
+};
+
+#endif /* MATRIXFLOAT_H */
@@ -0,0 +1,171 @@
+//
+//  OffsetHistogram.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include "OffsetHistogram.h"
+
+
+static const int initialSlotsLog2 = 6;
+
+OffsetHistogram::OffsetHistogram(int minOffset, int maxOffset) : minOffset(minOffset)
+{
+	int64_t size = ((int64_t)maxOffset - (int64_t)minOffset + 1);
+
+	isDense = (size <= maxDenseSize);
+	if (isDense) {
+		counts.resize((size > 0) ? (size_t)size : 0);
+	} else {
+		resize(initialSlotsLog2);
+	}
+}
+
+OffsetHistogram::OffsetHistogram() : isDense(false)
+{
+	resize(initialSlotsLog2);
+}
+
+int OffsetHistogram::getCount(int offset) const
+{
+	if (isDense) {
+		int64_t index = ((int64_t)offset - (int64_t)minOffset);
+		if ((index < 0) || (index >= (int64_t)counts.size())) {
+			return 0;
+		}
+		return (int)counts[(size_t)index];
+	}
+
+	return (int)counts[findSlot(offset)];
+}
+
+bool OffsetHistogram::getBestOffset(int &offset, int &count) const
+{
+	uint32_t bestCount = 0;
+	int bestOffset = 0;
+
+	if (isDense) {
+		// the first maximum is the smallest offset
+		int size = (int)counts.size();
+		for (int i = 0; i < size; i++) {
+			if (counts[i] > bestCount) {
+				bestCount = counts[i];
+				bestOffset = (minOffset + i);
+			}
+		}
+	} else {
+		int numSlots = (int)counts.size();
+		for (int i = 0; i < numSlots; i++) {
+			if ((counts[i] > bestCount) || ((counts[i] == bestCount) && (counts[i] > 0) && (offsets[i] < bestOffset))) {
+				bestCount = counts[i];
+				bestOffset = offsets[i];
+			}
+		}
+	}
+
+	if (bestCount == 0) {
+		return false;
+	}
+
+	offset = bestOffset;
+	count = (int)bestCount;
+	return true;
+}
+
+vector<OffsetCount> OffsetHistogram::getBestOffsets(int maxOffsets) const
+{
+	vector<OffsetCount> bestOffsets;
+	if (maxOffsets <= 0) {
+		return bestOffsets;
+	}
+
+	// a higher count first, then the smaller offset
+	auto isBetter = [](const OffsetCount &a, const OffsetCount &b) {
+		return ((a.count > b.count) || ((a.count == b.count) && (a.offset < b.offset)));
+	};
+
+	// keep the best offsets in a bounded heap, with the worst of them on top
+	bestOffsets.reserve(maxOffsets);
+	auto addOffset = [&](int offset, uint32_t count) {
+		OffsetCount offsetCount;
+		offsetCount.offset = offset;
+		offsetCount.count = (int)count;
+
+		if ((int)bestOffsets.size() < maxOffsets) {
+			bestOffsets.push_back(offsetCount);
+			std::push_heap(bestOffsets.begin(), bestOffsets.end(), isBetter);
+		} else if (isBetter(offsetCount, bestOffsets.front())) {
+			std::pop_heap(bestOffsets.begin(), bestOffsets.end(), isBetter);
+			bestOffsets.back() = offsetCount;
+			std::push_heap(bestOffsets.begin(), bestOffsets.end(), isBetter);
+		}
+	};
+
+	int size = (int)counts.size();
+	for (int i = 0; i < size; i++) {
+		if (counts[i] != 0) {
+			addOffset((isDense ? (minOffset + i) : offsets[i]), counts[i]);
+		}
+	}
+
+	std::sort_heap(bestOffsets.begin(), bestOffsets.end(), isBetter);
+	return bestOffsets;
+}
+
+// MARK: -
+// MARK: Private
+
+void OffsetHistogram::addSparse(int offset)
+{
+	int slot = findSlot(offset);
+	if (counts[slot] == 0) {
+		// keep the table at most half full
+		if (((numOffsets + 1) * 2) > (int)counts.size()) {
+			resize((32 - shift) + 1);
+			slot = findSlot(offset);
+		}
+
+		offsets[slot] = offset;
+		numOffsets += 1;
+	}
+
+	counts[slot] += 1;
+}
+
+int OffsetHistogram::findSlot(int offset) const
+{
+	int mask = ((int)counts.size() - 1);
+	int slot = (int)(((uint32_t)offset * 2654435769u) >> shift);
+
+	// linear probing
+	while ((counts[slot] != 0) && (offsets[slot] != offset)) {
+		slot = ((slot + 1) & mask);
+	}
+
+	return slot;
+}
+
+void OffsetHistogram::resize(int numSlotsLog2)
+{
+	vector<uint32_t> oldCounts;
+	vector<int> oldOffsets;
+	oldCounts.swap(counts);
+	oldOffsets.swap(offsets);
+
+	counts.assign(((size_t)1 << numSlotsLog2), 0);
+	offsets.assign(counts.size(), 0);
+	shift = (32 - numSlotsLog2);
+
+	// reinsert the counts
+	for (size_t i = 0; i < oldCounts.size(); i++) {
+		if (oldCounts[i] != 0) {
+			int slot = findSlot(oldOffsets[i]);
+			offsets[slot] = oldOffsets[i];
+			counts[slot] = oldCounts[i];
+		}
+	}
+}
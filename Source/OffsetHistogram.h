@@ -0,0 +1,72 @@
+//
+//  OffsetHistogram.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef OFFSETHISTOGRAM_H
+#define OFFSETHISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+using std::vector;
+
+struct OffsetCount {
+
+	int offset;
+	int count;
+
+};
+
+// Counts the matches at each position offset. The counts are kept in a dense array
+// when the range of the offsets is known and small enough, otherwise in an open
+// addressing hash table.
+class OffsetHistogram {
+
+public:
+
+	static const int maxDenseSize = (1 << 20);
+
+	// a histogram for offsets in the range minOffset - maxOffset (dense counts are not bounds
+	// checked, every offset that is added must be in the range)
+	OffsetHistogram(int minOffset, int maxOffset);
+	// a histogram for any offsets
+	OffsetHistogram();
+
+	inline void add(int offset)
+	{
+		if (isDense) {
+			counts[(offset - minOffset)] += 1;
+		} else {
+			addSparse(offset);
+		}
+	}
+
+	int getCount(int offset) const;
+
+	// the offset with the highest count (the smallest offset of ties), returns false if there are no counts
+	bool getBestOffset(int &offset, int &count) const;
+
+	// up to maxOffsets offsets with the highest counts, ordered by count (then offset)
+	vector<OffsetCount> getBestOffsets(int maxOffsets) const;
+
+private:
+
+	bool isDense;
+	int minOffset { 0 };
+	vector<uint32_t> counts;	// dense: count of each offset, sparse: count of each slot (0 for empty slots)
+	vector<int> offsets;		// sparse: offset of each slot
+	int numOffsets { 0 };		// sparse: number of used slots
+	int shift { 0 };			// sparse: hash shift
+
+	void addSparse(int offset);
+	int findSlot(int offset) const;
+	void resize(int numSlotsLog2);
+
+};
+
+#endif /* OFFSETHISTOGRAM_H */
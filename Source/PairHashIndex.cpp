@@ -0,0 +1,146 @@
+//
+//  PairHashIndex.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include "MappedPairHashIndex.h"
+#include "PairHashIndex.h"
+#include "PairPositionTable.h"
+
+using std::string;
+
+
+bool PairHashIndex::addReference(int referenceId, const FingerprintView &fingerprint)
+{
+	if (referenceSlots.find(referenceId) != referenceSlots.end()) {
+		return false;
+	}
+
+	int slot = (int)references.size();
+	referenceSlots[referenceId] = slot;
+
+	PairHashReference reference;
+	reference.referenceId = referenceId;
+	reference.numPoints = fingerprint.numPoints;
+	reference.numFrames = fingerprint.getNumFrames();
+	references.push_back(reference);
+
+	// add the postings
+	PairPositionTable table(fingerprint);
+	int numKeys = table.getNumKeys();
+	for (int key = 0; key < numKeys; key++) {
+		int numPositions = 0;
+		const int *positions = table.getPositions(key, numPositions);
+
+		vector<PairHashPosting> &hashPostings = postings[table.getKey(key)];
+		for (int i = 0; i < numPositions; i++) {
+			PairHashPosting posting;
+			posting.reference = slot;
+			posting.position = positions[i];
+			hashPostings.push_back(posting);
+		}
+	}
+
+	return true;
+}
+
+int PairHashIndex::addReferences(const int *referenceIds, const FingerprintView *fingerprints, int count)
+{
+	int numAdded = 0;
+
+	references.reserve(references.size() + count);
+	referenceSlots.reserve(referenceSlots.size() + count);
+
+	for (int i = 0; i < count; i++) {
+		if (addReference(referenceIds[i], fingerprints[i])) {
+			numAdded += 1;
+		}
+	}
+
+	return numAdded;
+}
+
+bool PairHashIndex::write(const char *filePath) const
+{
+	// sort the hashcodes
+	vector<int> keys;
+	keys.reserve(postings.size());
+	for (auto& it : postings) {
+		keys.push_back(it.first);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	// offsets of the postings of each hashcode
+	vector<uint64_t> offsets;
+	offsets.reserve(keys.size() + 1);
+	uint64_t numPostings = 0;
+	for (auto& key : keys) {
+		offsets.push_back(numPostings);
+		numPostings += postings.find(key)->second.size();
+	}
+	offsets.push_back(numPostings);
+
+	MappedPairHashIndex::Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MappedPairHashIndex::magic, sizeof(header.magic));
+	header.version = MappedPairHashIndex::version;
+	header.numReferences = (uint32_t)references.size();
+	header.numKeys = (uint32_t)keys.size();
+	header.numPostings = numPostings;
+
+	// write a temporary file next to the index file and move it into place, so a failed write
+	// leaves no partial index file (and an existing one unchanged)
+	string tempPath = (string(filePath) + ".tmp");
+	FILE *file = fopen(tempPath.c_str(), "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	bool success = ((fwrite(&header, sizeof(header), 1, file) == 1) &&
+					(fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size()) &&
+					(fwrite(keys.data(), sizeof(int32_t), keys.size(), file) == keys.size()) &&
+					(fwrite(references.data(), sizeof(PairHashReference), references.size(), file) == references.size()));
+
+	for (auto& key : keys) {
+		if (!success) {
+			break;
+		}
+
+		const vector<PairHashPosting> &hashPostings = postings.find(key)->second;
+		success = (fwrite(hashPostings.data(), sizeof(PairHashPosting), hashPostings.size(), file) == hashPostings.size());
+	}
+
+	if (fclose(file) != 0) {
+		success = false;
+	}
+
+	if (!success || (rename(tempPath.c_str(), filePath) != 0)) {
+		remove(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// MARK: -
+// MARK: Protected
+
+const PairHashPosting *PairHashIndex::getPostings(int hashcode, int &numPostings) const
+{
+	auto it = postings.find(hashcode);
+	if (it == postings.end()) {
+		numPostings = 0;
+		return nullptr;
+	}
+
+	numPostings = (int)it->second.size();
+	return it->second.data();
+}
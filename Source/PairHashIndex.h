@@ -0,0 +1,53 @@
+//
+//  PairHashIndex.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef PAIRHASHINDEX_H
+#define PAIRHASHINDEX_H
+
+#include <unordered_map>
+#include <vector>
+#include "PairHashIndexReader.h"
+
+using std::unordered_map;
+using std::vector;
+
+// An in-memory pair hash index that reference fingerprints are added to.
+class PairHashIndex : public PairHashIndexReader {
+
+public:
+
+	// add a reference fingerprint, returns false if the reference id is already used
+	bool addReference(int referenceId, const FingerprintView &fingerprint);
+	int addReferences(const int *referenceIds, const FingerprintView *fingerprints, int count);
+
+	// write the index file (see MappedPairHashIndex)
+	bool write(const char *filePath) const;
+
+	inline int getNumReferences() const override
+	{
+		return (int)references.size();
+	}
+
+protected:
+
+	const PairHashPosting *getPostings(int hashcode, int &numPostings) const override;
+
+	inline const PairHashReference &getReference(int slot) const override
+	{
+		return references[slot];
+	}
+
+private:
+
+	vector<PairHashReference> references;
+	unordered_map<int, int> referenceSlots;	// reference id: slot
+	unordered_map<int, vector<PairHashPosting>> postings;	// pair hashcode: postings
+
+};
+
+#endif /* PAIRHASHINDEX_H */
@@ -0,0 +1,79 @@
+//
+//  PairHashIndexReader.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include <unordered_map>
+#include "FingerprintSimilarityComputer.h"
+#include "PairHashIndexReader.h"
+#include "PairPositionTable.h"
+
+using std::unordered_map;
+
+
+vector<FingerprintIndexMatch> PairHashIndexReader::query(const FingerprintView &fingerprint, int maxMatches) const
+{
+	vector<FingerprintIndexMatch> matches;
+	if (maxMatches <= 0) {
+		return matches;
+	}
+
+	// offset histograms of the references that share a pair with the query
+	unordered_map<int, OffsetHistogram> offsetHistograms;
+
+	PairPositionTable table(fingerprint);
+	int numKeys = table.getNumKeys();
+	for (int key = 0; key < numKeys; key++) {
+		int numPostings = 0;
+		const PairHashPosting *postings = getPostings(table.getKey(key), numPostings);
+		if (numPostings == 0) {
+			continue;
+		}
+
+		int numPositions = 0;
+		const int *queryPositions = table.getPositions(key, numPositions);
+
+		for (int i = 0; i < numPostings; i++) {
+			const PairHashPosting &posting = postings[i];
+			OffsetHistogram &offsetHistogram = offsetHistograms[posting.reference];
+			for (int j = 0; j < numPositions; j++) {
+				offsetHistogram.add(posting.position - queryPositions[j]);
+			}
+		}
+	}
+
+	matches.reserve(offsetHistograms.size());
+	for (auto& it : offsetHistograms) {
+		const PairHashReference &reference = getReference(it.first);
+
+		// one frame may contain several points, use the shorter one be the denominator
+		int numFrames = ((reference.numPoints > fingerprint.numPoints) ? fingerprint.getNumFrames() : reference.numFrames);
+
+		FingerprintIndexMatch match;
+		match.referenceId = reference.referenceId;
+		match.similarity = FingerprintSimilarityComputer::getSimilarity(it.second, numFrames);
+		matches.push_back(match);
+	}
+
+	// keep the best matches
+	auto compare = [](const FingerprintIndexMatch &a, const FingerprintIndexMatch &b) {
+		if (a.similarity.score != b.similarity.score) {
+			return (a.similarity.score > b.similarity.score);
+		}
+		return (a.referenceId < b.referenceId);
+	};
+
+	if ((int)matches.size() > maxMatches) {
+		std::partial_sort(matches.begin(), (matches.begin() + maxMatches), matches.end(), compare);
+		matches.resize(maxMatches);
+	} else {
+		std::sort(matches.begin(), matches.end(), compare);
+	}
+
+	return matches;
+}
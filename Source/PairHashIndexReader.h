@@ -0,0 +1,58 @@
+//
+//  PairHashIndexReader.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef PAIRHASHINDEXREADER_H
+#define PAIRHASHINDEXREADER_H
+
+#include <stdint.h>
+#include <vector>
+#include "Fingerprint.h"
+#include "FingerprintPoints.h"
+
+using std::vector;
+
+// (the layout of these is also the layout in index files)
+struct PairHashReference {
+
+	int32_t referenceId;
+	int32_t numPoints;
+	int32_t numFrames;
+
+};
+
+struct PairHashPosting {
+
+	int32_t reference;	// reference slot
+	int32_t position;
+
+};
+
+// The lookup side of an inverted index from pair hashcodes to the positions of the
+// pair in the reference fingerprints. A query returns the same similarities as
+// comparing the pair tables of each reference (fingerprint1) and the query
+// (fingerprint2), for the references that share at least one pair with the query.
+class PairHashIndexReader {
+
+public:
+
+	virtual ~PairHashIndexReader() { }
+
+	// the best matching references, ordered by score (then reference id)
+	vector<FingerprintIndexMatch> query(const FingerprintView &fingerprint, int maxMatches) const;
+
+	virtual int getNumReferences() const = 0;
+
+protected:
+
+	// the postings of a pair hashcode, or nullptr if there are none
+	virtual const PairHashPosting *getPostings(int hashcode, int &numPostings) const = 0;
+	virtual const PairHashReference &getReference(int slot) const = 0;
+
+};
+
+#endif /* PAIRHASHINDEXREADER_H */
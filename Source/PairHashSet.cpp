@@ -0,0 +1,57 @@
+//
+//  PairHashSet.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <stdint.h>
+#include "PairHashSet.h"
+
+
+const int PairHashSet::emptySlot;
+
+void PairHashSet::insert(int hashcode)
+{
+	// keep the table at most half full
+	if (((numHashcodes + 1) * 2) > (int)slots.size()) {
+		resize(slots.empty() ? 16 : ((int)slots.size() * 2));
+	}
+
+	int slot = findSlot(hashcode);
+	if (slots[slot] == emptySlot) {
+		slots[slot] = hashcode;
+		numHashcodes += 1;
+	}
+}
+
+// MARK: -
+// MARK: Private
+
+int PairHashSet::findSlot(int hashcode) const
+{
+	int mask = ((int)slots.size() - 1);
+	uint32_t hash = ((uint32_t)hashcode * 2654435769u);
+	int slot = (int)((hash ^ (hash >> 16)) & (uint32_t)mask);
+
+	// linear probing
+	while ((slots[slot] != emptySlot) && (slots[slot] != hashcode)) {
+		slot = ((slot + 1) & mask);
+	}
+
+	return slot;
+}
+
+void PairHashSet::resize(int numSlots)
+{
+	vector<int> oldSlots(numSlots, emptySlot);
+	oldSlots.swap(slots);
+
+	for (auto& hashcode : oldSlots) {
+		if (hashcode != emptySlot) {
+			slots[findSlot(hashcode)] = hashcode;
+		}
+	}
+}
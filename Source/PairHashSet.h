@@ -0,0 +1,40 @@
+//
+//  PairHashSet.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef PAIRHASHSET_H
+#define PAIRHASHSET_H
+
+#include <vector>
+
+using std::vector;
+
+// A set of pair hashcodes (which are never negative) in a flat open addressing table.
+class PairHashSet {
+
+public:
+
+	void insert(int hashcode);
+
+	inline bool contains(int hashcode) const
+	{
+		return ((numHashcodes > 0) && (slots[findSlot(hashcode)] == hashcode));
+	}
+
+private:
+
+	static const int emptySlot = -1;
+
+	vector<int> slots;
+	int numHashcodes { 0 };
+
+	int findSlot(int hashcode) const;
+	void resize(int numSlots);
+
+};
+
+#endif /* PAIRHASHSET_H */
@@ -7,9 +7,10 @@
 //
 
 
-#include "FingerprintManager.h"
+#include <algorithm>
 #include "PairManager.h"
 #include "QuickSortInteger.h"
+#include "RadixSortInteger.h"
 
 
 PairManager::PairManager()
@@ -31,36 +32,10 @@ PairManager::PairManager(bool isReferencePairing) : isReferencePairing(isReferen
 	}
 }
 
-/**
-* Get a pair-positionList table
-* It's a hash map which the key is the hashed pair, and the value is list of positions
-* That means the table stores the positions which have the same hashed pair
-*/
-
-map<int, vector<int>> PairManager::getPair_PositionList_Table(const vector<uint8_t> &fingerprint)
-{
-	vector<PairPosition> pairPositionList = getPairPositionList(fingerprint);
-
-	// table to store pair: pos, pos, pos, ...; pair2: pos, pos, pos, ...
-	map<int, vector<int>> pair_positionList_table;
-
-	// get all pair positions from list, use a table to collect the data group by pair hashcode
-	for (auto& pairPosition : pairPositionList) {
-		// group by pair-hashcode, i.e.: <pair, List<position>>
-		vector<int> &array = pair_positionList_table[pairPosition.hashcode];
-		array.push_back(pairPosition.position);
-	}
-
-	return pair_positionList_table;
-}
-
-// MARK: -
-// MARK: Private
-
 // this return list contains: int[0] = pair_hashcode, int[1] = position
-vector<PairPosition> PairManager::getPairPositionList(const vector<uint8_t> &fingerprint)
+vector<PairPosition> PairManager::getPairPositionList(const FingerprintView &fingerprint)
 {
-	int numFrames = FingerprintManager::getNumFrames(fingerprint);
+	int numFrames = fingerprint.getNumFrames();
 
 	// table for paired frames
 	vector<uint8_t> pairedFrameTable((numFrames / anchorPointsIntervalLength + 1));
@@ -68,11 +43,50 @@ vector<PairPosition> PairManager::getPairPositionList(const vector<uint8_t> &fin
 	// each second has numAnchorPointsPerSecond pairs only
 	vector<PairPosition> pairList;
 	vector<ArrayCoord> sortedCoordinateList = getSortedCoordinateList(fingerprint);
+	int numPoints = (int)sortedCoordinateList.size();
+
+	// bucket the points by frame and filter bank, only points within the target zone of the
+	// same filter bank can be paired (the ranks in each bucket are in intensity order)
+	int numBanks = 1;
+	for (auto& point : sortedCoordinateList) {
+		numBanks = std::max(numBanks, ((point.y / bandwidthPerBank) + 1));
+	}
+
+	vector<int> bucketOffsets(((numFrames * numBanks) + 1));
+	for (auto& point : sortedCoordinateList) {
+		bucketOffsets[((point.x * numBanks) + (point.y / bandwidthPerBank) + 1)] += 1;
+	}
+	for (size_t bucket = 1; bucket < bucketOffsets.size(); bucket++) {
+		bucketOffsets[bucket] += bucketOffsets[bucket - 1];
+	}
+
+	vector<int> bucketRanks(numPoints);
+	vector<int> bucketFill(bucketOffsets.begin(), (bucketOffsets.end() - 1));
+	for (int rank = 0; rank < numPoints; rank++) {
+		const ArrayCoord &point = sortedCoordinateList[rank];
+		bucketRanks[bucketFill[((point.x * numBanks) + (point.y / bandwidthPerBank))]++] = rank;
+	}
+
+	vector<int> targetRanks;
 
 	for (auto& anchorPoint : sortedCoordinateList) {
 		int numPairs = 0;
 
-		for (auto& targetPoint : sortedCoordinateList) {
+		// the targets in the target zone, in the same order as the sorted coordinate list
+		// (skipping the other targets keeps the pairs the same, the limits only change when a pair is added)
+		int bank = (anchorPoint.y / bandwidthPerBank);
+		int firstFrame = std::max((anchorPoint.x - maxTargetZoneDistance), 0);
+		int lastFrame = std::min((anchorPoint.x + maxTargetZoneDistance), (numFrames - 1));
+
+		targetRanks.clear();
+		for (int frame = firstFrame; frame <= lastFrame; frame++) {
+			int bucket = ((frame * numBanks) + bank);
+			targetRanks.insert(targetRanks.end(), (bucketRanks.begin() + bucketOffsets[bucket]), (bucketRanks.begin() + bucketOffsets[bucket + 1]));
+		}
+		std::sort(targetRanks.begin(), targetRanks.end());
+
+		for (auto& targetRank : targetRanks) {
+			const ArrayCoord &targetPoint = sortedCoordinateList[targetRank];
 
 			if (numPairs >= maxPairs) {
 				break;
@@ -118,7 +132,7 @@ vector<PairPosition> PairManager::getPairPositionList(const vector<uint8_t> &fin
 			int pairHashcode = (x2 - x1) * numFrequencyUnits * numFrequencyUnits + y2 * numFrequencyUnits + y1;
 
 			// stop list applied on sample pairing only
-			if (!isReferencePairing && (stopPairTable.find(pairHashcode) != stopPairTable.end())) {
+			if (!isReferencePairing && stopPairTable.contains(pairHashcode)) {
 				numPairs += 1;	// no reservation
 				continue;	// escape this point only
 			}
@@ -133,34 +147,34 @@ vector<PairPosition> PairManager::getPairPositionList(const vector<uint8_t> &fin
 	return pairList;
 }
 
-vector<ArrayCoord> PairManager::getSortedCoordinateList(const vector<uint8_t> &fingerprint)
+// MARK: -
+// MARK: Private
+
+vector<ArrayCoord> PairManager::getSortedCoordinateList(const FingerprintView &fingerprint)
 {
-	// each point data is 8 bytes
-	// x: 2 byte integer
-	// y: 2 byte integer
-	// intensity: 4 bytes
+	const FingerprintPoints &points = *fingerprint.points;
 
 	// get all intensities
-	int numCoordinates = ((int)fingerprint.size() / 8);
-	vector<int> intensities(numCoordinates);
-
-	for (int i = 0; i < numCoordinates; i++) {
-		int pointer = (i * 8 + 4);
-		int intensity = (int)(fingerprint[pointer] & 0xFF) << 24 | (int)(fingerprint[pointer + 1] & 0xFF) << 16 | (int)(fingerprint[pointer + 2] & 0xFF) << 8 | (int)(fingerprint[pointer + 3] & 0xFF);
-		intensities[i] = intensity;
+	vector<int> intensities(points.intensity.begin(), (points.intensity.begin() + fingerprint.numPoints));
+
+	// radix sort, unless equal intensities need the tie order of the quick sort
+	// (when all intensities differ both sorts give the same order)
+	vector<int> sortIndexes;
+	if (FingerprintProperties::stableIntensityOrder || !RadixSortInteger::containsEqualValues(intensities)) {
+		RadixSortInteger radixsort(intensities);
+		sortIndexes = radixsort.getSortIndexes();
+	} else {
+		QuickSortInteger quicksort(intensities);
+		sortIndexes = quicksort.getSortIndexes();
 	}
 
-	QuickSortInteger quicksort(intensities);
-	vector<int> sortIndexes = quicksort.getSortIndexes();
-
 	vector<ArrayCoord> sortedCoordinateList;
+	sortedCoordinateList.reserve(sortIndexes.size());
 	int i = ((int)sortIndexes.size() - 1);
 
 	while (i >= 0) {
-		int pointer = (sortIndexes[i] * 8);
-		int x = (((int)fingerprint[pointer + 0] << 8) | (int)fingerprint[pointer + 1]);
-		int y = (((int)fingerprint[pointer + 2] << 8) | (int)fingerprint[pointer + 3]);
-		sortedCoordinateList.push_back(ArrayCoord(x, y));
+		int index = sortIndexes[i];
+		sortedCoordinateList.push_back(ArrayCoord(points.x[index], points.y[index]));
 		i -= 1;
 	}
 
@@ -9,12 +9,12 @@
 #ifndef PAIRMANAGER_H
 #define PAIRMANAGER_H
 
-#include <map>
 #include <vector>
 #include "ArrayCoord.h"
+#include "FingerprintPoints.h"
 #include "FingerprintProperties.h"
+#include "PairHashSet.h"
 
-using std::map;
 using std::vector;
 
 struct PairPosition {
@@ -33,7 +33,8 @@ public:
 	PairManager();
 	PairManager(bool isReferencePairing);
 
-	map<int, vector<int>> getPair_PositionList_Table(const vector<uint8_t> &fingerprint);
+	// the pairs of the fingerprint in pairing order
+	vector<PairPosition> getPairPositionList(const FingerprintView &fingerprint);
 
 private:
 
@@ -51,11 +52,10 @@ private:
 	int bandwidthPerBank;
 	int maxPairs;
 	bool isReferencePairing { true };
-	map<int, bool> stopPairTable;
+	PairHashSet stopPairTable;
 
 
-	vector<PairPosition> getPairPositionList(const vector<uint8_t> &fingerprint);
-	vector<ArrayCoord> getSortedCoordinateList(const vector<uint8_t> &fingerprint);
+	vector<ArrayCoord> getSortedCoordinateList(const FingerprintView &fingerprint);
 
 };
 
@@ -0,0 +1,60 @@
+//
+//  PairPositionTable.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include "PairManager.h"
+#include "PairPositionTable.h"
+
+
+PairPositionTable::PairPositionTable(const FingerprintView &fingerprint) : numPoints(fingerprint.numPoints), numFrames(fingerprint.getNumFrames())
+{
+	PairManager pairManager;
+	vector<PairPosition> pairPositionList = pairManager.getPairPositionList(fingerprint);
+
+	// group by pair hashcode, keeping the pairing order of the positions
+	std::stable_sort(pairPositionList.begin(), pairPositionList.end(), [](const PairPosition &a, const PairPosition &b) {
+		return (a.hashcode < b.hashcode);
+	});
+
+	positions.reserve(pairPositionList.size());
+	for (auto& pairPosition : pairPositionList) {
+		if (keys.empty() || (keys.back() != pairPosition.hashcode)) {
+			keys.push_back(pairPosition.hashcode);
+			offsets.push_back((int)positions.size());
+		}
+		positions.push_back(pairPosition.position);
+	}
+	offsets.push_back((int)positions.size());
+}
+
+int PairPositionTable::findKey(int hashcode) const
+{
+	auto it = std::lower_bound(keys.begin(), keys.end(), hashcode);
+	if ((it == keys.end()) || (*it != hashcode)) {
+		return -1;
+	}
+
+	return (int)(it - keys.begin());
+}
+
+int PairPositionTable::skipToKey(int startIndex, int hashcode) const
+{
+	int numKeys = (int)keys.size();
+
+	// find a range that contains the key by doubling the step
+	int low = startIndex;
+	int step = 1;
+	while (((low + step) < numKeys) && (keys[(low + step)] < hashcode)) {
+		low += step;
+		step *= 2;
+	}
+
+	int high = std::min((low + step + 1), numKeys);
+	return (int)(std::lower_bound((keys.begin() + low), (keys.begin() + high), hashcode) - keys.begin());
+}
@@ -0,0 +1,68 @@
+//
+//  PairPositionTable.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef PAIRPOSITIONTABLE_H
+#define PAIRPOSITIONTABLE_H
+
+#include <vector>
+#include "FingerprintPoints.h"
+
+using std::vector;
+
+// The pair hashcode - position list table of a fingerprint (see PairManager), built
+// once so that the fingerprint can be compared many times. The hashcodes are sorted
+// and the positions of each hashcode are contiguous (in pairing order).
+class PairPositionTable {
+
+public:
+
+	PairPositionTable(const FingerprintView &fingerprint);
+
+	inline int getNumKeys() const
+	{
+		return (int)keys.size();
+	}
+
+	inline int getKey(int index) const
+	{
+		return keys[index];
+	}
+
+	inline const int *getPositions(int index, int &numPositions) const
+	{
+		numPositions = (offsets[index + 1] - offsets[index]);
+		return (positions.data() + offsets[index]);
+	}
+
+	// the index of a hashcode, or -1 if the table does not contain it
+	int findKey(int hashcode) const;
+
+	// the index of the first key from startIndex on that is not less than hashcode (exponential search)
+	int skipToKey(int startIndex, int hashcode) const;
+
+	inline int getNumPoints() const
+	{
+		return numPoints;
+	}
+
+	inline int getNumFrames() const
+	{
+		return numFrames;
+	}
+
+private:
+
+	vector<int> keys;		// sorted pair hashcodes
+	vector<int> offsets;	// first position of each key (and the end)
+	vector<int> positions;
+	int numPoints;
+	int numFrames;
+
+};
+
+#endif /* PAIRPOSITIONTABLE_H */
@@ -0,0 +1,97 @@
+//
+//  RadixSortInteger.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <stdint.h>
+#include <algorithm>
+#include "RadixSortInteger.h"
+
+
+// MARK: Static
+
+bool RadixSortInteger::containsEqualValues(const vector<int> &array)
+{
+	// open addressing set of the values, at most half full (empty slots hold a value outside the int range)
+	const uint64_t emptySlot = UINT64_MAX;
+	int numSlotsLog2 = 4;
+	while ((1 << numSlotsLog2) < ((int)array.size() * 2)) {
+		numSlotsLog2 += 1;
+	}
+
+	vector<uint64_t> slots(((size_t)1 << numSlotsLog2), emptySlot);
+	uint32_t mask = (uint32_t)(slots.size() - 1);
+
+	for (auto& value : array) {
+		uint64_t item = (uint32_t)value;
+		uint32_t slot = ((((uint32_t)value * 2654435769u) >> (32 - numSlotsLog2)) & mask);
+
+		// linear probing
+		while (slots[slot] != emptySlot) {
+			if (slots[slot] == item) {
+				return true;
+			}
+			slot = ((slot + 1) & mask);
+		}
+		slots[slot] = item;
+	}
+
+	return false;
+}
+
+// MARK: -
+
+RadixSortInteger::RadixSortInteger(const vector<int> &array) : array(array)
+{
+}
+
+vector<int> RadixSortInteger::getSortIndexes()
+{
+	int count = (int)array.size();
+	int numDigits = (1 << digitBits);
+	uint32_t digitMask = (uint32_t)(numDigits - 1);
+
+	// the values biased to unsigned order in the high half, the index in the low half
+	vector<uint64_t> items(count);
+	vector<uint64_t> sorted(count);
+	for (int i = 0; i < count; i++) {
+		uint32_t key = ((uint32_t)array[i] ^ 0x80000000u);
+		items[i] = (((uint64_t)key << 32) | (uint32_t)i);
+	}
+
+	vector<int> histogram(numDigits);
+	for (int shift = 32; shift < 64; shift += digitBits) {
+		std::fill(histogram.begin(), histogram.end(), 0);
+		for (auto& item : items) {
+			histogram[((item >> shift) & digitMask)] += 1;
+		}
+
+		// skip the digits that are the same for all values
+		if ((count == 0) || (histogram[((items[0] >> shift) & digitMask)] == count)) {
+			continue;
+		}
+
+		int offset = 0;
+		for (auto& digitCount : histogram) {
+			int digitOffset = offset;
+			offset += digitCount;
+			digitCount = digitOffset;
+		}
+
+		for (auto& item : items) {
+			sorted[histogram[((item >> shift) & digitMask)]++] = item;
+		}
+		items.swap(sorted);
+	}
+
+	vector<int> indexes(count);
+	for (int i = 0; i < count; i++) {
+		indexes[i] = (int)(uint32_t)items[i];
+	}
+
+	return indexes;
+}
@@ -0,0 +1,38 @@
+//
+//  RadixSortInteger.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef RADIXSORTINTEGER_H
+#define RADIXSORTINTEGER_H
+
+#include <vector>
+
+using std::vector;
+
+// LSD radix sort of (value, index) pairs. Equal values keep their index order, so the
+// result only matches QuickSortInteger when all the values are different.
+class RadixSortInteger {
+
+public:
+
+	// true if any values are equal, without sorting (stops at the first repeated value)
+	static bool containsEqualValues(const vector<int> &array);
+
+	RadixSortInteger(const vector<int> &array);
+
+	// the indexes in ascending order of the values
+	vector<int> getSortIndexes();
+
+private:
+
+	static const int digitBits = 11;
+
+	vector<int> array;
+
+};
+
+#endif /* RADIXSORTINTEGER_H */
@@ -7,40 +7,75 @@
 //
 
 
-#include "ArrayRankFloat.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "RobustIntensityProcessor.h"
 
+using std::vector;
 
-RobustIntensityProcessor::RobustIntensityProcessor(const vector<vector<float>> &intensities, int numPointsPerFrame) : intensities(intensities), numPointsPerFrame(numPointsPerFrame)
+
+RobustIntensityProcessor::RobustIntensityProcessor(int numPointsPerFrame) : numPointsPerFrame(numPointsPerFrame)
 {
 }
 
-void RobustIntensityProcessor::execute()
+float RobustIntensityProcessor::getPassValue(const float *row, int count) const
 {
-	int numX = (int)intensities.size();
-	int numY = (int)intensities[0].size();
-	vector<vector<float>> processedIntensities;
+	// a single pass for the largest value
+	if (numPointsPerFrame <= 1) {
+		float passValue = row[0];
+		for (int j = 1; j < count; j++) {
+			if (row[j] > passValue) {
+				passValue = row[j];
+			}
+		}
+		return passValue;
+	}
+
+	// every value passes when the row is not longer than the number of points
+	if (numPointsPerFrame >= count) {
+		return *std::min_element(row, (row + count));
+	}
+
+	// keep the numPointsPerFrame largest values in a min-heap, the top is the pass value
+	if (numPointsPerFrame <= maxHeapSize) {
+		float heap[maxHeapSize];
+		int heapSize = numPointsPerFrame;
+		std::copy(row, (row + heapSize), heap);
+		std::make_heap(heap, (heap + heapSize), std::greater<float>());
 
-	for (int i = 0; i < numX; i++) {
-		processedIntensities.push_back(vector<float>(numY));
+		for (int j = heapSize; j < count; j++) {
+			if (row[j] > heap[0]) {
+				std::pop_heap(heap, (heap + heapSize), std::greater<float>());
+				heap[heapSize - 1] = row[j];
+				std::push_heap(heap, (heap + heapSize), std::greater<float>());
+			}
+		}
+
+		return heap[0];
 	}
 
-	for (int i = 0; i < numX; i++) {
+	vector<float> values(row, (row + count));
+	std::nth_element(values.begin(), (values.begin() + (count - numPointsPerFrame)), values.end());
+	return values[count - numPointsPerFrame];
+}
 
-		// TODO: Optimization: Using a sorted array is overkill.
-		// Instead find the smallest value and use that as the pass value.
+int RobustIntensityProcessor::getRobustIndices(const float *row, int count, int *indices) const
+{
+	if (count <= 0) {
+		return 0;
+	}
 
-		// pass value is the last some elements in sorted array
-		ArrayRankFloat arrayRankFloat(intensities[i]);
-		float passValue = arrayRankFloat.getNthOrderedValue(numPointsPerFrame, false);
+	float passValue = getPassValue(row, count);
 
-		// only passed elements will be assigned a value
-		for (int j = 0; j < numY; j++) {
-			if (intensities[i][j] >= passValue) {
-				processedIntensities[i][j] = intensities[i][j];
-			}
+	// only passed elements are robust points
+	int numIndices = 0;
+	for (int j = 0; j < count; j++) {
+		if (row[j] >= passValue) {
+			indices[numIndices] = j;
+			numIndices += 1;
 		}
 	}
 
-	intensities = processedIntensities;
+	return numIndices;
 }
@@ -9,19 +9,26 @@
 #ifndef ROBUSTINTENSITYPROCESSOR_H
 #define ROBUSTINTENSITYPROCESSOR_H
 
-#include <vector>
-
-using std::vector;
-
+// Selects the robust points of a row of intensities, the values that are at least
+// the numPointsPerFrame-th largest value (ties included, so there can be more).
+// The rows are read in place.
 class RobustIntensityProcessor {
 
 public:
 
-	vector<vector<float>> intensities;
 	int numPointsPerFrame;
 
-	RobustIntensityProcessor(const vector<vector<float>> &intensities, int numPointsPerFrame);
-	void execute();
+	RobustIntensityProcessor(int numPointsPerFrame);
+
+	// the pass value, the numPointsPerFrame-th largest value (the smallest value if the row is shorter)
+	float getPassValue(const float *row, int count) const;
+
+	// write the indices of the values >= the pass value in ascending order, returns the number of indices (up to count)
+	int getRobustIndices(const float *row, int count, int *indices) const;
+
+private:
+
+	static const int maxHeapSize = 16;	// larger selections use nth_element on a copy of the row
 
 };
 
@@ -7,122 +7,250 @@
 //
 
 
+#include <algorithm>
 #include <float.h>
 #include <math.h>
-#include "FastFourierTransform.h"
+#include "FingerprintProperties.h"
+#include "FloatLanesSIMD.h"
 #include "Spectrogram.h"
+#include "SpectrogramKernel.h"
+#include "ThreadPool.h"
 #include "WindowFunction.h"
 
+#if defined(__SSE2__)
+typedef SpectrogramKernel<FloatLanesSSE> Kernel;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+typedef SpectrogramKernel<FloatLanesNEON> Kernel;
+#else
+typedef SpectrogramKernel<FloatLanes<4>> Kernel;
+#endif
 
-Spectrogram::Spectrogram(vector<int16_t> wave, int fftSampleSize, int overlapFactor) : fftSampleSize(fftSampleSize), overlapFactor(overlapFactor)
+
+Spectrogram::Spectrogram(const int16_t *wave, int numSamples, int fftSampleSize, int overlapFactor, SpectrogramNormalizationType normalization) : Spectrogram(fftSampleSize, overlapFactor, normalization)
+{
+	build(wave, numSamples);
+}
+
+Spectrogram::Spectrogram(int fftSampleSize, int overlapFactor, SpectrogramNormalizationType normalization) : fftSampleSize(fftSampleSize), overlapFactor(overlapFactor), normalization(normalization), fft(fftSampleSize)
+{
+	hopSize = getHopSize(fftSampleSize, overlapFactor);
+	window = WindowFunction::generate(WindowFunctionType::hamming, fftSampleSize);
+}
+
+void Spectrogram::build(const int16_t *wave, int numSamples)
 {
 	waveData = wave;
-	waveDuration = ((float)waveData.size() / sampleRate);
+	numWaveSamples = numSamples;
+	waveDuration = ((float)numWaveSamples / sampleRate);
 
 	buildSpectrogram();
+
+	// the wave is not owned
+	waveData = nullptr;
 }
 
 
-// MARK: -
-// MARK: Private
+// MARK: Static
 
-void Spectrogram::buildSpectrogram()
+int Spectrogram::getHopSize(int fftSampleSize, int overlapFactor)
 {
-	vector<int16_t> amplitudes = waveData;
-	int numSamples = (int)amplitudes.size();
-
-	// create the overlapping amplitude data
-	if (overlapFactor > 1) {
-		int numOverlappedSamples = (numSamples * overlapFactor);
-		int backSamples = fftSampleSize * (overlapFactor - 1) / overlapFactor;
-		int fftSampleSize_1 = (fftSampleSize - 1);
-		vector<int16_t> overlapAmp(numOverlappedSamples);
-		int pointer = 0;
-		int i = 0;
-		while (i < (int)amplitudes.size()) {
-			overlapAmp[pointer] = amplitudes[i];
-			pointer += 1;
-			if ((pointer % fftSampleSize) == fftSampleSize_1) {
-				// overlap
-				i -= backSamples;
-			}
-			i += 1;
+	// frames overlap by 1 / overlapFactor
+	int backSamples = (overlapFactor > 1) ? (fftSampleSize * (overlapFactor - 1) / overlapFactor) : 0;
+	return (fftSampleSize - backSamples);
+}
+
+void Spectrogram::windowSamples(const int16_t *samples, int numSamples, int fftSampleSize, int hopSize, const float *window, float *signal)
+{
+	// Frame k reads the samples k * hopSize + n for n < fftSampleSize - 1. The last
+	// element of each frame is sample (k + 1) * hopSize - 1, and framing stops at the
+	// first frame that runs past the end of the wave, leaving its tail and all later
+	// frames zero. This is the layout of the original overlapped sample buffer.
+	int fftSampleSize_1 = (fftSampleSize - 1);
+
+	if (numSamples >= std::max(fftSampleSize_1, hopSize)) {
+		for (int n = 0; n < fftSampleSize_1; n++) {
+			signal[n] = ((float)samples[n] * window[n]);
 		}
-		numSamples = numOverlappedSamples;
-		amplitudes = overlapAmp;
+		signal[fftSampleSize_1] = ((float)samples[hopSize - 1] * window[fftSampleSize_1]);
+		return;
 	}
 
-	// number of frames of the spectrogram
-	int numFrames = (numSamples / fftSampleSize);
+	// partial frame
+	for (int n = 0; n < fftSampleSize; n++) {
+		signal[n] = (n < numSamples) ? ((float)samples[n] * window[n]) : 0.0f;
+	}
+}
+
+void Spectrogram::scanAmplitudes(const float *frame, int count, float &minAmplitude, float &maxAmplitude)
+{
+	// The minimum is only checked when the value is not a new maximum. Once the first
+	// minimum is set it is below the maximum, from then on this is a plain min / max.
+	int j = 0;
+	for (; (j < count) && (minAmplitude > maxAmplitude); j++) {
+		if (frame[j] > maxAmplitude) {
+			maxAmplitude = frame[j];
+		} else if (frame[j] < minAmplitude) {
+			minAmplitude = frame[j];
+		}
+	}
 
-	// TODO: Optimization: Use vDSP for the window function.
-	// TODO: Optimization: Only generate the window function once.
+	Kernel::scanRange((frame + j), (count - j), minAmplitude, maxAmplitude);
+}
 
-	// create the signals array for fft
-	vector<float> window = WindowFunction::generate(WindowFunctionType::hamming, fftSampleSize);
+void Spectrogram::normalizeFrame(const float *absoluteFrame, float *frame, int count, float minAmplitude, float maxAmplitude)
+{
+	// safety check the minimum amplitude to avoid divide by zero
+	float minValidAmplitude = 0.00000000001f;
+	if (minAmplitude == 0.0f) {
+		minAmplitude = minValidAmplitude;
+	}
 
-	vector<vector<float>> signals(numFrames);
-	for (int x = 0; x < numFrames; x++) {
-		signals[x].resize(fftSampleSize);
+	if (FingerprintProperties::fastLogarithm) {
+		Kernel::normalize(absoluteFrame, frame, count, minAmplitude, maxAmplitude, minValidAmplitude);
+		return;
 	}
 
-	for (int frameIndex = 0; frameIndex < numFrames; frameIndex++) {
-		int startSample = (frameIndex * fftSampleSize);
-		for (int n = 0; n < fftSampleSize; n++) {
-			signals[frameIndex][n] = ((float)amplitudes[startSample + n] * window[n]);
+	float diff = log10f(maxAmplitude / minAmplitude);	// perceptual difference
+	for (int j = 0; j < count; j++) {
+		if (absoluteFrame[j] < minValidAmplitude) {
+			frame[j] = 0.0f;
+		} else {
+			frame[j] = ((log10f(absoluteFrame[j] / minAmplitude)) / diff);
 		}
 	}
+}
 
-	// TODO: Optimization: Move the FFT setup elsewhere (instead of setting up every time).
+// MARK: -
+// MARK: Private
 
-	absoluteSpectrogram.resize(numFrames);
-	// for each frame in signals, do fft on it
-	FastFourierTransform fft(fftSampleSize);
-	for (int i = 0; i < numFrames; i++) {
-		absoluteSpectrogram[i] = fft.getMagnitudes(signals[i]);
+void Spectrogram::buildSpectrogram()
+{
+	// number of frames of the spectrogram
+	int numFrames = (int)(((int64_t)numWaveSamples * std::max(overlapFactor, 1)) / fftSampleSize);
+
+	// do fft on all frames
+	int numFrequencyUnit = fft.getNumMagnitudes();
+	SpectrogramNormalizer normalizer(normalization, numFrequencyUnit);
+	spectrogram.resize(numFrames, numFrequencyUnit);
+
+	if ((pool != nullptr) && (pool->getNumThreads() > 1) && (numFrames > numFramesPerTask)) {
+		buildSpectrogramParallel(numFrames, normalizer);
+		return;
 	}
 
-	if (absoluteSpectrogram.size() > 0) {
+	// only the global range needs the magnitudes of every frame, the other ranges normalize each chunk after its fft
+	bool isGlobal = (normalization == SpectrogramNormalizationType::global);
+	absoluteSpectrogram.resize((isGlobal ? numFrames : std::min(numFrames, (int)numFramesPerChunk)), numFrequencyUnit);
 
-		// number of y-axis unit
-		int numFrequencyUnit = (int)absoluteSpectrogram[0].size();
+	// window the frames straight into the fft input, one chunk of frames at a time
+	signals.resize(std::min(numFrames, (int)numFramesPerChunk), fftSampleSize);
 
-		// get max and min amplitudes of the absoluteSpectrogram
-		float maxAmplitude = FLT_MIN;
-		float minAmplitude = FLT_MAX;
+	for (int chunkStart = 0; chunkStart < numFrames; chunkStart += numFramesPerChunk) {
+		int numChunkFrames = std::min((int)numFramesPerChunk, (numFrames - chunkStart));
 
-		for(int i = 0; i < numFrames; i++) {
-			for (int j = 0; j < numFrequencyUnit; j++) {
-				if (absoluteSpectrogram[i][j] > maxAmplitude) {
-					maxAmplitude = absoluteSpectrogram[i][j];
-				} else if (absoluteSpectrogram[i][j] < minAmplitude) {
-					minAmplitude = absoluteSpectrogram[i][j];
-				}
+		int absoluteStart = (isGlobal ? chunkStart : 0);
+		transformChunk(chunkStart, numChunkFrames, fft, signals, absoluteSpectrogram[absoluteStart], absoluteSpectrogram.getStride());
+
+		if (!isGlobal) {
+			for (int frameIndex = 0; frameIndex < numChunkFrames; frameIndex++) {
+				normalizer.addFrame(absoluteSpectrogram[frameIndex]);
+				normalizer.normalizeFrame(absoluteSpectrogram[frameIndex], spectrogram[chunkStart + frameIndex]);
 			}
 		}
+	}
+
+	// normalize with the amplitude range of all frames, each as one sweep over the spectrogram
+	if (isGlobal && (numFrames > 0)) {
+		normalizer.addFrames(absoluteSpectrogram[0], numFrames, absoluteSpectrogram.getStride());
+		normalizer.normalizeFrames(absoluteSpectrogram[0], spectrogram[0], numFrames, spectrogram.getStride());
+	}
+}
+
+void Spectrogram::buildSpectrogramParallel(int numFrames, SpectrogramNormalizer &normalizer)
+{
+	int numFrequencyUnit = fft.getNumMagnitudes();
+	int numTasks = ((numFrames + numFramesPerTask - 1) / numFramesPerTask);
+
+	if (chunkWorkers.size() != (size_t)pool->getNumThreads()) {
+		chunkWorkers.resize(pool->getNumThreads());
+	}
+
+	// the magnitudes of every frame, each task transforms the same chunks as a serial build
+	// (the fft of a chunk depends on how its frames are batched)
+	absoluteSpectrogram.resize(numFrames, numFrequencyUnit);
 
-		// safety check the minimum amplitude to avoid divide by zero
-		float minValidAmplitude = 0.00000000001f;
-		if (minAmplitude == 0.0f) {
-			minAmplitude = minValidAmplitude;
+	pool->run(numTasks, [&](int task, int worker) {
+		ChunkWorker &chunkWorker = chunkWorkers[worker];
+		if (!chunkWorker.fft) {
+			chunkWorker.fft.reset(new FastFourierTransform(fftSampleSize, fft.getBackendType()));
+			chunkWorker.signals.resize(numFramesPerChunk, fftSampleSize);
 		}
 
-		// normalize the absolute spectrogram
-		spectrogram.resize(numFrames);
-		for (int x = 0; x < numFrames; x++) {
-			spectrogram[x].resize(numFrequencyUnit);
+		int taskEnd = std::min(((task + 1) * numFramesPerTask), numFrames);
+		for (int chunkStart = (task * numFramesPerTask); chunkStart < taskEnd; chunkStart += numFramesPerChunk) {
+			int numChunkFrames = std::min((int)numFramesPerChunk, (taskEnd - chunkStart));
+			transformChunk(chunkStart, numChunkFrames, *chunkWorker.fft, chunkWorker.signals, absoluteSpectrogram[chunkStart], absoluteSpectrogram.getStride());
 		}
+	});
 
-		float diff = log10f(maxAmplitude / minAmplitude);	// perceptual difference
-		for (int i = 0; i < numFrames; i++) {
-			for (int j = 0; j < numFrequencyUnit; j++) {
-				if (absoluteSpectrogram[i][j] < minValidAmplitude) {
-					spectrogram[i][j] = 0.0f;
-				} else {
-					spectrogram[i][j] = ((log10f(absoluteSpectrogram[i][j] / minAmplitude)) / diff);
-				}
-			}
+	// the other ranges depend on the frames before, they are normalized in order
+	if (normalization != SpectrogramNormalizationType::global) {
+		for (int frameIndex = 0; frameIndex < numFrames; frameIndex++) {
+			normalizer.addFrame(absoluteSpectrogram[frameIndex]);
+			normalizer.normalizeFrame(absoluteSpectrogram[frameIndex], spectrogram[frameIndex]);
 		}
+		return;
+	}
 
+	// the first values set the range in order (see scanAmplitudes), after that the range is a
+	// plain min / max of the frames, reduced per task and merged
+	int firstScanFrame = 0;
+	while ((firstScanFrame < numFrames) && !normalizer.hasAmplitudeRange()) {
+		normalizer.addFrame(absoluteSpectrogram[firstScanFrame]);
+		firstScanFrame += 1;
 	}
+
+	vector<float> taskMinAmplitudes(numTasks, normalizer.getMinAmplitude());
+	vector<float> taskMaxAmplitudes(numTasks, normalizer.getMaxAmplitude());
+
+	pool->run(numTasks, [&](int task, int /*worker*/) {
+		int taskStart = std::max((task * numFramesPerTask), firstScanFrame);
+		int taskEnd = std::min(((task + 1) * numFramesPerTask), numFrames);
+		for (int frameIndex = taskStart; frameIndex < taskEnd; frameIndex++) {
+			scanAmplitudes(absoluteSpectrogram[frameIndex], numFrequencyUnit, taskMinAmplitudes[task], taskMaxAmplitudes[task]);
+		}
+	});
+
+	for (int task = 0; task < numTasks; task++) {
+		normalizer.addAmplitudeRange(taskMinAmplitudes[task], taskMaxAmplitudes[task]);
+	}
+
+	pool->run(numTasks, [&](int task, int /*worker*/) {
+		int taskStart = (task * numFramesPerTask);
+		int taskEnd = std::min((taskStart + numFramesPerTask), numFrames);
+		normalizer.normalizeFrames(absoluteSpectrogram[taskStart], spectrogram[taskStart], (taskEnd - taskStart), spectrogram.getStride());
+	});
+}
+
+void Spectrogram::transformChunk(int chunkStart, int numChunkFrames, FastFourierTransform &chunkFFT, MatrixFloat &chunkSignals, float *magnitudes, int magnitudesStride)
+{
+	for (int frameIndex = 0; frameIndex < numChunkFrames; frameIndex++) {
+		windowFrame((chunkStart + frameIndex), chunkSignals[frameIndex]);
+	}
+
+	chunkFFT.getMagnitudes(chunkSignals.getRow(0), chunkSignals.getStride(), numChunkFrames, magnitudes, magnitudesStride);
+}
+
+void Spectrogram::windowFrame(int frameIndex, float *signal)
+{
+	int64_t start = ((int64_t)frameIndex * hopSize);
+	int fftSampleSize_1 = (fftSampleSize - 1);
+
+	// only the frame where the wave ends has samples, the frames after it are empty
+	int numValid = 0;
+	if ((start < numWaveSamples) && ((frameIndex == 0) || ((start - hopSize + fftSampleSize_1 - 1) < numWaveSamples))) {
+		numValid = (int)std::min((int64_t)(numWaveSamples - start), (int64_t)fftSampleSize);
+	}
+
+	windowSamples((waveData + std::min(start, (int64_t)numWaveSamples)), numValid, fftSampleSize, hopSize, window.data(), signal);
 }
@@ -9,18 +9,57 @@
 #ifndef SPECTROGRAM_H
 #define SPECTROGRAM_H
 
+#include <memory>
 #include <vector>
+#include "FastFourierTransform.h"
 #include "FingerprintProperties.h"
+#include "MatrixFloat.h"
+#include "SpectrogramNormalizer.h"
 
+using std::unique_ptr;
 using std::vector;
 
+class ThreadPool;
+
 class Spectrogram {
 
 public:
 
-	Spectrogram(vector<int16_t> wave, int fftSampleSize, int overlapFactor);
+	// samples between the starts of consecutive frames
+	static int getHopSize(int fftSampleSize, int overlapFactor);
+
+	// window one frame, numSamples are the samples available from the start of the frame
+	static void windowSamples(const int16_t *samples, int numSamples, int fftSampleSize, int hopSize, const float *window, float *signal);
+
+	// update the amplitude range with a frame of magnitudes
+	static void scanAmplitudes(const float *frame, int count, float &minAmplitude, float &maxAmplitude);
+
+	// log-normalize a frame of magnitudes against the amplitude range
+	static void normalizeFrame(const float *absoluteFrame, float *frame, int count, float minAmplitude, float maxAmplitude);
+
+	// the wave is read in place and must stay valid for the duration of the constructor
+	Spectrogram(const int16_t *wave, int numSamples, int fftSampleSize, int overlapFactor, SpectrogramNormalizationType normalization = SpectrogramNormalizationType::global);
+
+	// a spectrogram for build(), which reuses the window, fft and buffers for each wave
+	Spectrogram(int fftSampleSize, int overlapFactor, SpectrogramNormalizationType normalization = SpectrogramNormalizationType::global);
+
+	// build the spectrogram of a wave (read in place for the duration of the call)
+	void build(const int16_t *wave, int numSamples);
+
+	// split the frames of long waves across a thread pool (not owned, nullptr to build on the calling thread),
+	// the spectrogram is the same as a serial build
+	inline void setThreadPool(ThreadPool *pool)
+	{
+		this->pool = pool;
+	}
+
+	inline SpectrogramNormalizationType getNormalization() const
+	{
+		return normalization;
+	}
 
-	inline const vector<vector<float>>& getNormalizedSpectrogramData()
+	// frames x frequency units
+	inline const MatrixFloat& getNormalizedSpectrogramData()
 	{
 		return spectrogram;
 	}
@@ -29,16 +68,41 @@ private:
 
 	float sampleRate = FingerprintProperties::sampleRate;
 
-	vector<vector<float>> absoluteSpectrogram;
-	vector<vector<float>> spectrogram;	// relative spectrogram
-	vector<int16_t> waveData;
+	MatrixFloat absoluteSpectrogram;
+	MatrixFloat spectrogram;	// relative spectrogram
+	const int16_t *waveData { nullptr };
+	int numWaveSamples { 0 };
 	float waveDuration { 0.0f };
 
 	int fftSampleSize;	// number of samples in fft, the value needed to be a number to power of 2
 	int overlapFactor;	// 1 / overlapFactor overlapping, e.g. 1 / 4 = 25% overlapping
+	int hopSize { 0 };	// samples between the starts of consecutive frames
+	SpectrogramNormalizationType normalization;
+
+	vector<float> window;
+	FastFourierTransform fft;	// the fft plan is shared between spectrograms
+	MatrixFloat signals;		// the windowed frames of a chunk
+
+	static const int numFramesPerChunk = 64;	// frames windowed and transformed per fft call
+
+	// the fft and buffers of each worker of the thread pool
+	struct ChunkWorker {
+
+		unique_ptr<FastFourierTransform> fft;
+		MatrixFloat signals;
+
+	};
+
+	ThreadPool *pool { nullptr };
+	vector<ChunkWorker> chunkWorkers;
+
+	static const int numFramesPerTask = (numFramesPerChunk * 16);	// frames per pool task (whole chunks)
 
 
 	void buildSpectrogram();
+	void buildSpectrogramParallel(int numFrames, SpectrogramNormalizer &normalizer);
+	void transformChunk(int chunkStart, int numChunkFrames, FastFourierTransform &chunkFFT, MatrixFloat &chunkSignals, float *magnitudes, int magnitudesStride);
+	void windowFrame(int frameIndex, float *signal);
 
 };
 
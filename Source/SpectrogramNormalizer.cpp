@@ -0,0 +1,123 @@
+//
+//  SpectrogramNormalizer.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include <algorithm>
+#include <float.h>
+#include "FingerprintProperties.h"
+#include "Spectrogram.h"
+#include "SpectrogramNormalizer.h"
+
+
+SpectrogramNormalizer::SpectrogramNormalizer(SpectrogramNormalizationType type, int numFrequencyUnits) : type(type), numFrequencyUnits(numFrequencyUnits)
+{
+	switch (type) {
+		case SpectrogramNormalizationType::fixedReference:
+			minAmplitude = FingerprintProperties::normalizationMinAmplitude;
+			maxAmplitude = FingerprintProperties::normalizationMaxAmplitude;
+			break;
+
+		case SpectrogramNormalizationType::windowed:
+			frameMinAmplitudes.resize(std::max(FingerprintProperties::normalizationWindowFrames, 1), FLT_MAX);
+			frameMaxAmplitudes.resize(std::max(FingerprintProperties::normalizationWindowFrames, 1), FLT_MIN);
+			// fall through
+
+		default:
+			minAmplitude = FLT_MAX;
+			maxAmplitude = FLT_MIN;
+			break;
+	}
+}
+
+void SpectrogramNormalizer::addFrame(const float *absoluteFrame)
+{
+	switch (type) {
+		case SpectrogramNormalizationType::global:
+		case SpectrogramNormalizationType::running:
+			Spectrogram::scanAmplitudes(absoluteFrame, numFrequencyUnits, minAmplitude, maxAmplitude);
+			break;
+
+		case SpectrogramNormalizationType::windowed: {
+			// replace the range of the oldest frame in the window
+			int numWindowFrames = (int)frameMinAmplitudes.size();
+			int slot = (int)(numFrames % numWindowFrames);
+			float frameMinAmplitude = FLT_MAX;
+			float frameMaxAmplitude = FLT_MIN;
+			for (int j = 0; j < numFrequencyUnits; j++) {
+				frameMinAmplitude = std::min(frameMinAmplitude, absoluteFrame[j]);
+				frameMaxAmplitude = std::max(frameMaxAmplitude, absoluteFrame[j]);
+			}
+			frameMinAmplitudes[slot] = frameMinAmplitude;
+			frameMaxAmplitudes[slot] = frameMaxAmplitude;
+
+			minAmplitude = *std::min_element(frameMinAmplitudes.begin(), frameMinAmplitudes.end());
+			maxAmplitude = *std::max_element(frameMaxAmplitudes.begin(), frameMaxAmplitudes.end());
+			break;
+		}
+
+		case SpectrogramNormalizationType::fixedReference:
+			break;
+	}
+
+	numFrames += 1;
+}
+
+void SpectrogramNormalizer::addAmplitudeRange(float minAmplitude, float maxAmplitude)
+{
+	this->minAmplitude = std::min(this->minAmplitude, minAmplitude);
+	this->maxAmplitude = std::max(this->maxAmplitude, maxAmplitude);
+}
+
+void SpectrogramNormalizer::normalizeFrame(const float *absoluteFrame, float *frame) const
+{
+	normalize(absoluteFrame, frame, numFrequencyUnits);
+}
+
+void SpectrogramNormalizer::addFrames(const float *absoluteFrames, int numFrames, int stride)
+{
+	// the global and running ranges scan packed frames in one sweep
+	bool isScan = ((type == SpectrogramNormalizationType::global) || (type == SpectrogramNormalizationType::running));
+	if (!isScan || (stride != numFrequencyUnits)) {
+		for (int i = 0; i < numFrames; i++) {
+			addFrame(absoluteFrames + ((size_t)i * stride));
+		}
+		return;
+	}
+
+	for (int i = 0; i < numFrames; i += numFramesPerSweep) {
+		int count = (std::min((int)numFramesPerSweep, (numFrames - i)) * numFrequencyUnits);
+		Spectrogram::scanAmplitudes((absoluteFrames + ((size_t)i * stride)), count, minAmplitude, maxAmplitude);
+	}
+
+	this->numFrames += numFrames;
+}
+
+void SpectrogramNormalizer::normalizeFrames(const float *absoluteFrames, float *frames, int numFrames, int stride) const
+{
+	// the padding between the frames is zero and normalizes to zero, so the frames are normalized in one sweep
+	for (int i = 0; i < numFrames; i += numFramesPerSweep) {
+		int count = (((std::min((int)numFramesPerSweep, (numFrames - i)) - 1) * stride) + numFrequencyUnits);
+		size_t offset = ((size_t)i * stride);
+		normalize((absoluteFrames + offset), (frames + offset), count);
+	}
+}
+
+// MARK: -
+// MARK: Private
+
+void SpectrogramNormalizer::normalize(const float *absoluteValues, float *values, int count) const
+{
+	Spectrogram::normalizeFrame(absoluteValues, values, count, minAmplitude, maxAmplitude);
+
+	// magnitudes outside of the fixed range are clipped
+	if (type == SpectrogramNormalizationType::fixedReference) {
+		for (int j = 0; j < count; j++) {
+			values[j] = std::min(std::max(values[j], 0.0f), 1.0f);
+		}
+	}
+}
@@ -0,0 +1,88 @@
+//
+//  SpectrogramNormalizer.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef SPECTROGRAMNORMALIZER_H
+#define SPECTROGRAMNORMALIZER_H
+
+#include <stdint.h>
+#include <vector>
+
+using std::vector;
+
+enum class SpectrogramNormalizationType {
+	global,			// amplitude range of the whole clip (needs every frame before the first is normalized)
+	running,		// amplitude range of the frames so far
+	windowed,		// amplitude range of the last normalizationWindowFrames frames
+	fixedReference	// fixed amplitude range (normalizationMinAmplitude - normalizationMaxAmplitude)
+};
+
+// Log-normalizes spectrogram frames against an amplitude range.
+// Frames are added in order, only the global range has to see every frame before normalizing.
+class SpectrogramNormalizer {
+
+public:
+
+	SpectrogramNormalizer(SpectrogramNormalizationType type, int numFrequencyUnits);
+
+	inline SpectrogramNormalizationType getType() const
+	{
+		return type;
+	}
+
+	// the current amplitude range
+	inline float getMinAmplitude() const
+	{
+		return minAmplitude;
+	}
+
+	inline float getMaxAmplitude() const
+	{
+		return maxAmplitude;
+	}
+
+	// whether the first magnitudes have set the range, from then on the global range is a plain min / max
+	// that frames can be scanned for in any order (see Spectrogram::scanAmplitudes)
+	inline bool hasAmplitudeRange() const
+	{
+		return (minAmplitude <= maxAmplitude);
+	}
+
+	// widen the global range with the range of frames that were scanned separately
+	void addAmplitudeRange(float minAmplitude, float maxAmplitude);
+
+	// add the next frame of magnitudes to the amplitude range
+	void addFrame(const float *absoluteFrame);
+
+	// log-normalize a frame of magnitudes against the current amplitude range
+	void normalizeFrame(const float *absoluteFrame, float *frame) const;
+
+	// add / normalize consecutive frames that are stride floats apart
+	void addFrames(const float *absoluteFrames, int numFrames, int stride);
+	void normalizeFrames(const float *absoluteFrames, float *frames, int numFrames, int stride) const;
+
+private:
+
+	static const int numFramesPerSweep = 4096;
+
+	SpectrogramNormalizationType type;
+	int numFrequencyUnits;
+
+	float minAmplitude;
+	float maxAmplitude;
+
+	// windowed range, per frame ranges of the last numWindowFrames frames
+	vector<float> frameMinAmplitudes;
+	vector<float> frameMaxAmplitudes;
+	int64_t numFrames { 0 };
+
+
+	void normalize(const float *absoluteValues, float *values, int count) const;
+
+};
+
+#endif /* SPECTROGRAMNORMALIZER_H */
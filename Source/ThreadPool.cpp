@@ -0,0 +1,151 @@
+//
+//  ThreadPool.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+
+#include "ThreadPool.h"
+
+using std::lock_guard;
+using std::unique_lock;
+
+
+// MARK: Static
+
+int ThreadPool::getDefaultNumThreads()
+{
+	int numCores = (int)thread::hardware_concurrency();
+	return ((numCores > 0) ? numCores : 1);
+}
+
+// MARK: -
+
+ThreadPool::ThreadPool(int numThreads)
+{
+	if (numThreads <= 0) {
+		numThreads = getDefaultNumThreads();
+	}
+
+	for (int i = 0; i < numThreads; i++) {
+		workers.push_back(unique_ptr<Worker>(new Worker));
+	}
+
+	for (int i = 0; i < numThreads; i++) {
+		threads.push_back(thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(stateMutex);
+		isStopping = true;
+	}
+	startCondition.notify_all();
+
+	for (auto& workerThread : threads) {
+		workerThread.join();
+	}
+}
+
+void ThreadPool::run(int count, const function<void(int, int)> &task)
+{
+	if (count <= 0) {
+		return;
+	}
+
+	lock_guard<mutex> runLock(runMutex);
+
+	// deal the tasks out in contiguous ranges
+	int numWorkers = (int)workers.size();
+	for (int w = 0; w < numWorkers; w++) {
+		int start = (int)(((int64_t)count * w) / numWorkers);
+		int end = (int)(((int64_t)count * (w + 1)) / numWorkers);
+
+		lock_guard<mutex> queueLock(workers[w]->queueMutex);
+		for (int index = start; index < end; index++) {
+			workers[w]->queue.push_back(index);
+		}
+	}
+
+	// start the batch
+	{
+		lock_guard<mutex> lock(stateMutex);
+		batchTask = &task;
+		numFinishedWorkers = 0;
+		batchNumber += 1;
+	}
+	startCondition.notify_all();
+
+	// wait until every worker is out of tasks (so no worker is still in this batch when the next one is dealt out)
+	unique_lock<mutex> lock(stateMutex);
+	doneCondition.wait(lock, [&]() { return (numFinishedWorkers == numWorkers); });
+	batchTask = nullptr;
+}
+
+// MARK: -
+// MARK: Private
+
+void ThreadPool::workerLoop(int worker)
+{
+	uint64_t lastBatchNumber = 0;
+
+	while (true) {
+		const function<void(int, int)> *task = nullptr;
+
+		// wait for a new batch
+		{
+			unique_lock<mutex> lock(stateMutex);
+			startCondition.wait(lock, [&]() { return (isStopping || (batchNumber != lastBatchNumber)); });
+			if (isStopping) {
+				return;
+			}
+
+			lastBatchNumber = batchNumber;
+			task = batchTask;
+		}
+
+		int index = 0;
+		while (takeTask(worker, index)) {
+			(*task)(index, worker);
+		}
+
+		// done with this batch (a task still running keeps its worker from finishing)
+		{
+			lock_guard<mutex> lock(stateMutex);
+			numFinishedWorkers += 1;
+		}
+		doneCondition.notify_all();
+	}
+}
+
+bool ThreadPool::takeTask(int worker, int &index)
+{
+	// the front of the own queue
+	{
+		Worker &own = *workers[worker];
+		lock_guard<mutex> lock(own.queueMutex);
+		if (!own.queue.empty()) {
+			index = own.queue.front();
+			own.queue.pop_front();
+			return true;
+		}
+	}
+
+	// steal from the back of the other queues
+	int numWorkers = (int)workers.size();
+	for (int n = 1; n < numWorkers; n++) {
+		Worker &other = *workers[((worker + n) % numWorkers)];
+		lock_guard<mutex> lock(other.queueMutex);
+		if (!other.queue.empty()) {
+			index = other.queue.back();
+			other.queue.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,78 @@
+//
+//  ThreadPool.h
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/16/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::condition_variable;
+using std::deque;
+using std::function;
+using std::mutex;
+using std::thread;
+using std::unique_ptr;
+using std::vector;
+
+// A fixed set of worker threads that run the tasks of a batch. Each worker takes tasks
+// from the front of its own queue and steals from the back of the other queues when
+// its own queue is empty.
+class ThreadPool {
+
+public:
+
+	// the number of cores (at least 1)
+	static int getDefaultNumThreads();
+
+	// numThreads 0 for the default
+	ThreadPool(int numThreads);
+	~ThreadPool();
+
+	inline int getNumThreads() const
+	{
+		return (int)threads.size();
+	}
+
+	// run task(index, worker) for each index below count, returns when all tasks are done
+	// (worker is the index of the thread running the task, for state that is kept per worker,
+	// tasks must not call run on the same pool)
+	void run(int count, const function<void(int, int)> &task);
+
+private:
+
+	struct Worker {
+
+		mutex queueMutex;
+		deque<int> queue;
+
+	};
+
+	vector<thread> threads;
+	vector<unique_ptr<Worker>> workers;
+
+	mutex runMutex;		// one batch at a time
+	mutex stateMutex;
+	condition_variable startCondition;
+	condition_variable doneCondition;
+	const function<void(int, int)> *batchTask { nullptr };
+	uint64_t batchNumber { 0 };
+	int numFinishedWorkers { 0 };	// workers that found no more tasks in the batch
+	bool isStopping { false };
+
+	void workerLoop(int worker);
+	bool takeTask(int worker, int &index);
+
+};
+
+#endif /* THREADPOOL_H */
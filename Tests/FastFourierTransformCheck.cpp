@@ -0,0 +1,161 @@
+//
+//  FastFourierTransformCheck.cpp
+//  TuneURL
+//
+//  Created by agent <agent@local> on 10/17/26.
+//  Copyright (c) 2026 TuneURL Inc. All rights reserved.
+//
+
+// Checks the batched fft kernel of every instruction set against the single frame
+// transform (FloatLanes<1>) on random frames. The FastFourierTransformCheck target of the
+// Xcode project builds and runs it, or build and run it from the repository root:
+//
+//	c++ -std=c++14 -O2 -ISource Tests/FastFourierTransformCheck.cpp Source/FastFourierTransform*.cpp -o fftcheck && ./fftcheck
+//
+// (add -framework Accelerate on macOS). Kernels that are not supported by the build or
+// the cpu are skipped. Without fused multiply-adds the kernels are bit-exact, otherwise
+// each magnitude must be within maxRelativeError of the largest magnitude of its frame.
+// Returns 1 if any kernel is outside the bound.
+
+#include <math.h>
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include "FastFourierTransformJava.h"
+
+using std::vector;
+
+
+static const float maxRelativeError = 1e-5f;
+
+struct CheckResult {
+
+	int numFrames { 0 };
+	int numExactFrames { 0 };
+	float maxError { 0.0f };	// relative to the largest magnitude of the frame
+
+};
+
+static void fillFrame(std::mt19937 &random, int kind, float *frame, int numSamples)
+{
+	std::uniform_real_distribution<float> sample(-32768.0f, 32767.0f);
+	std::uniform_real_distribution<float> frequency(0.001f, 0.499f);
+
+	switch (kind) {
+		case 0:
+			// noise
+			for (int n = 0; n < numSamples; n++) {
+				frame[n] = sample(random);
+			}
+			break;
+
+		case 1: {
+			// two tones
+			float frequency1 = frequency(random);
+			float frequency2 = frequency(random);
+			for (int n = 0; n < numSamples; n++) {
+				frame[n] = ((12000.0f * sinf(6.2831853f * frequency1 * n)) + (3000.0f * sinf(6.2831853f * frequency2 * n)));
+			}
+			break;
+		}
+
+		case 2:
+			// silence with a few clicks
+			for (int n = 0; n < numSamples; n++) {
+				frame[n] = (((random() % 97) == 0) ? sample(random) : 0.0f);
+			}
+			break;
+
+		default:
+			// silence
+			for (int n = 0; n < numSamples; n++) {
+				frame[n] = 0.0f;
+			}
+			break;
+	}
+}
+
+static CheckResult checkInstructionSet(FastFourierTransformInstructionSet instructionSet, int numSamples, int numBatches, std::mt19937 &random)
+{
+	CheckResult result;
+
+	FastFourierTransformJava batched(numSamples);
+	FastFourierTransformJava single(numSamples);
+	batched.setInstructionSet(instructionSet);
+
+	int numMagnitudes = batched.getNumMagnitudes();
+	vector<float> frames;
+	vector<float> magnitudes;
+	vector<float> expected(numMagnitudes);
+
+	for (int batch = 0; batch < numBatches; batch++) {
+		// full and partial batches (a single frame does not use the batched kernel)
+		int numFrames = (2 + (int)(random() % (3 * batched.getNumFramesPerBatch())));
+		frames.resize((size_t)numFrames * numSamples);
+		magnitudes.resize((size_t)numFrames * numMagnitudes);
+
+		for (int f = 0; f < numFrames; f++) {
+			fillFrame(random, (int)(random() % 4), &frames[(size_t)f * numSamples], numSamples);
+		}
+
+		batched.getMagnitudes(frames.data(), numSamples, numFrames, magnitudes.data(), numMagnitudes);
+
+		for (int f = 0; f < numFrames; f++) {
+			single.getMagnitudes(&frames[(size_t)f * numSamples], numSamples, 1, expected.data(), numMagnitudes);
+
+			const float *frameMagnitudes = &magnitudes[(size_t)f * numMagnitudes];
+			float maxMagnitude = 0.0f;
+			float maxDifference = 0.0f;
+			bool isExact = true;
+			for (int c = 0; c < numMagnitudes; c++) {
+				maxMagnitude = fmaxf(maxMagnitude, fabsf(expected[c]));
+				maxDifference = fmaxf(maxDifference, fabsf(frameMagnitudes[c] - expected[c]));
+				isExact = (isExact && (frameMagnitudes[c] == expected[c]));
+			}
+
+			result.numFrames += 1;
+			if (isExact) {
+				result.numExactFrames += 1;
+			} else {
+				float error = ((maxMagnitude > 0.0f) ? (maxDifference / maxMagnitude) : maxDifference);
+				result.maxError = fmaxf(result.maxError, error);
+			}
+		}
+	}
+
+	return result;
+}
+
+int main()
+{
+	const struct {
+		FastFourierTransformInstructionSet instructionSet;
+		const char *name;
+	} instructionSets[] = {
+		{ FastFourierTransformInstructionSet::scalar, "scalar" },
+		{ FastFourierTransformInstructionSet::sse, "sse" },
+		{ FastFourierTransformInstructionSet::avx2, "avx2" },
+		{ FastFourierTransformInstructionSet::neon, "neon" }
+	};
+	const int sampleSizes[] = { 64, 1024, 2048 };
+
+	std::mt19937 random(20261016);
+	bool success = true;
+
+	for (auto& instructionSet : instructionSets) {
+		if (FastFourierTransformSIMD::get(instructionSet.instructionSet) == NULL) {
+			printf("%-6s  not supported\n", instructionSet.name);
+			continue;
+		}
+
+		for (int numSamples : sampleSizes) {
+			CheckResult result = checkInstructionSet(instructionSet.instructionSet, numSamples, 40, random);
+			bool isWithinBound = (result.maxError <= maxRelativeError);
+			success = (success && isWithinBound);
+
+			printf("%-6s  %4d samples  %4d frames  %4d bit-exact  max error %g  %s\n", instructionSet.name, numSamples, result.numFrames, result.numExactFrames, result.maxError, (isWithinBound ? "ok" : "FAILED"));
+		}
+	}
+
+	return (success ? 0 : 1);
+}